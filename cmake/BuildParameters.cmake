@@ -31,6 +31,7 @@ if(DISABLE_BUILD_DATE OR openSUSE)
 endif()
 
 option(USE_VTUNE "Plug VTUNE to profile GSdx JIT.")
+option(USE_PERF_JITDUMP "Write a perf jitdump of the recompilers and GSdx JIT (Linux)")
 
 #-------------------------------------------------------------------------------
 # Graphical option
@@ -318,6 +319,10 @@ if(USE_VTUNE)
     set(COMMON_FLAG "${COMMON_FLAG} -DENABLE_VTUNE")
 endif()
 
+if(USE_PERF_JITDUMP)
+    set(COMMON_FLAG "${COMMON_FLAG} -DENABLE_PERF_JITDUMP")
+endif()
+
 # Remove FORTIFY_SOURCE when compiling as debug, because it spams a lot of warnings on clang due to no optimization.
 if (CMAKE_BUILD_TYPE MATCHES "Debug")
 set(HARDENING_FLAG "-Wformat -Wformat-security")
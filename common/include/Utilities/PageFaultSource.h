@@ -27,13 +27,21 @@
 #include "EventSource.h"
 #include <atomic>
 
+enum PageFaultAccess {
+    PageFaultAccess_Unknown = 0,
+    PageFaultAccess_Read,
+    PageFaultAccess_Write,
+};
+
 struct PageFaultInfo
 {
-    uptr addr;
+    uptr addr;             // faulting address (not rounded down to the page)
+    PageFaultAccess access; // Unknown when the host does not report it
 
-    PageFaultInfo(uptr address)
+    PageFaultInfo(uptr address, PageFaultAccess type = PageFaultAccess_Unknown)
     {
         addr = address;
+        access = type;
     }
 };
 
@@ -18,6 +18,9 @@
 namespace Perf
 {
 
+// Fills dest with the guest symbol of pc (ie "main+0x10"), returns false if there is none.
+typedef bool (*SymbolLookup)(u32 pc, char *dest, size_t size);
+
 struct Info
 {
     uptr m_x86;
@@ -37,6 +40,7 @@ class InfoVector
     std::vector<Info> m_v;
     char m_prefix[20];
     unsigned int m_vtune_id;
+    SymbolLookup m_lookup;
 
 public:
     InfoVector(const char *prefix);
@@ -45,8 +49,12 @@ public:
     void map(uptr x86, u32 size, const char *symbol);
     void map(uptr x86, u32 size, u32 pc);
     void reset();
+    void set_symbols(SymbolLookup lookup) { m_lookup = lookup; }
 };
 
+// Registers code generated outside of the InfoVectors (GSdx JIT) in the jitdump.
+void jit_load(uptr x86, u32 size, const char *symbol);
+
 void dump();
 void dump_and_reset();
 
@@ -175,6 +175,8 @@ extern void xSAHF();
 extern void xSTC();
 extern void xCLC();
 
+extern void xRDTSC();
+
 // NOP 1-byte
 extern void xNOP();
 
@@ -23,6 +23,7 @@
 #include <signal.h>
 #include <errno.h>
 #include <unistd.h>
+#include <ucontext.h>
 
 // Apple uses the MAP_ANON define instead of MAP_ANONYMOUS, but they mean
 // the same thing.
@@ -32,10 +33,9 @@
 
 extern void SignalExit(int sig);
 
-static const uptr m_pagemask = getpagesize() - 1;
 
 // Linux implementation of SIGSEGV handler.  Bind it using sigaction().
-static void SysPageFaultSignalFilter(int signal, siginfo_t *siginfo, void *)
+static void SysPageFaultSignalFilter(int signal, siginfo_t *siginfo, void *context)
 {
     // [TODO] : Add a thread ID filter to the Linux Signal handler here.
     // Rationale: On windows, the __try/__except model allows per-thread specific behavior
@@ -59,7 +59,13 @@ static void SysPageFaultSignalFilter(int signal, siginfo_t *siginfo, void *)
     // so for now we lock this exception code unless someone can fix this better...
     Threading::ScopedLock lock(PageFault_Mutex);
 
-    Source_PageFault->Dispatch(PageFaultInfo((uptr)siginfo->si_addr & ~m_pagemask));
+    PageFaultAccess access = PageFaultAccess_Unknown;
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+    // Bit 1 of the x86 page fault error code is set for write accesses.
+    access = (((ucontext_t *)context)->uc_mcontext.gregs[REG_ERR] & 2) ? PageFaultAccess_Write : PageFaultAccess_Read;
+#endif
+
+    Source_PageFault->Dispatch(PageFaultInfo((uptr)siginfo->si_addr, access));
 
     // resumes execution right where we left off (re-executes instruction that
     // caused the SIGSEGV).
@@ -21,6 +21,15 @@
 #include "unistd.h"
 #endif
 
+#if defined(__linux__) && defined(ENABLE_PERF_JITDUMP)
+#include <elf.h>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 //#define ProfileWithPerf
 #define MERGE_BLOCK_RESULT
 
@@ -42,7 +51,145 @@ InfoVector vu("VU");
 InfoVector vif("VIF");
 
 // Perf is only supported on linux
-#if defined(__linux__) && (defined(ProfileWithPerf) || defined(ENABLE_VTUNE))
+#if defined(__linux__) && (defined(ProfileWithPerf) || defined(ENABLE_VTUNE) || defined(ENABLE_PERF_JITDUMP))
+
+#ifdef ENABLE_PERF_JITDUMP
+
+////////////////////////////////////////////////////////////////////////////////
+// perf jitdump (tools/perf/Documentation/jitdump-specification.txt)
+////////////////////////////////////////////////////////////////////////////////
+// Every block is written along with its code when it is compiled, so samples taken in
+// blocks that were thrown away since are still attributed. Usage:
+//   perf record -k mono ...
+//   perf inject --jit -i perf.data -o perf.jit.data
+//   perf report -i perf.jit.data
+//
+// The code never moves once compiled (a reset just reuses the addresses, perf sorts it out
+// with the timestamps), so only code load records are written.
+
+struct JitDumpHeader
+{
+    u32 magic;
+    u32 version;
+    u32 total_size;
+    u32 elf_mach;
+    u32 pad1;
+    u32 pid;
+    u64 timestamp;
+    u64 flags;
+};
+
+struct JitDumpCodeLoad
+{
+    u32 id;
+    u32 total_size;
+    u64 timestamp;
+    u32 pid;
+    u32 tid;
+    u64 vma;
+    u64 code_addr;
+    u64 code_size;
+    u64 code_index;
+    // followed by the null terminated name and the code
+};
+
+static const u32 JIT_CODE_LOAD = 0;
+
+// Blocks are compiled on the EE, MTVU and GS threads
+static std::mutex s_jitdump_lock;
+static FILE *s_jitdump = NULL;
+static bool s_jitdump_failed = false;
+static u64 s_jitdump_index = 0;
+
+static u64 jitdump_timestamp()
+{
+    // Must match the clock given to perf record (-k mono)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static bool jitdump_open()
+{
+    if (s_jitdump)
+        return true;
+    if (s_jitdump_failed)
+        return false;
+
+    s_jitdump_failed = true;
+
+    char file[256];
+    snprintf(file, sizeof(file), "/tmp/jit-%d.dump", getpid());
+    int fd = open(file, O_CREAT | O_TRUNC | O_RDWR, 0666);
+    if (fd < 0)
+        return false;
+
+    // perf finds the dump through an executable mapping of it, it is kept until exit.
+    void *marker = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ | PROT_EXEC, MAP_PRIVATE, fd, 0);
+    if (marker == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+
+    s_jitdump = fdopen(fd, "wb");
+    if (!s_jitdump) {
+        close(fd);
+        return false;
+    }
+
+    JitDumpHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = 0x4A695444; // "JiTD"
+    header.version = 1;
+    header.total_size = sizeof(header);
+#ifdef __x86_64__
+    header.elf_mach = EM_X86_64;
+#else
+    header.elf_mach = EM_386;
+#endif
+    header.pid = getpid();
+    header.timestamp = jitdump_timestamp();
+
+    fwrite(&header, sizeof(header), 1, s_jitdump);
+
+    s_jitdump_failed = false;
+    return true;
+}
+
+static void jitdump_load(uptr x86, u32 size, const char *name)
+{
+    std::lock_guard<std::mutex> lock(s_jitdump_lock);
+
+    if (!size || !jitdump_open())
+        return;
+
+    u32 name_size = strlen(name) + 1;
+
+    JitDumpCodeLoad rec;
+    rec.id = JIT_CODE_LOAD;
+    rec.total_size = sizeof(rec) + name_size + size;
+    rec.timestamp = jitdump_timestamp();
+    rec.pid = getpid();
+    rec.tid = syscall(SYS_gettid);
+    rec.vma = x86;
+    rec.code_addr = x86;
+    rec.code_size = size;
+    rec.code_index = s_jitdump_index++;
+
+    fwrite(&rec, sizeof(rec), 1, s_jitdump);
+    fwrite(name, name_size, 1, s_jitdump);
+    fwrite((void *)x86, size, 1, s_jitdump);
+}
+
+static void jitdump_flush()
+{
+    std::lock_guard<std::mutex> lock(s_jitdump_lock);
+
+    if (s_jitdump)
+        fflush(s_jitdump);
+}
+
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 // Implementation of the Info object
@@ -66,7 +213,7 @@ Info::Info(uptr x86, u32 size, const char *symbol, u32 pc)
 
 void Info::Print(FILE *fp)
 {
-    fprintf(fp, "%x %x %s\n", m_x86, m_size, m_symbol);
+    fprintf(fp, "%lx %x %s\n", (unsigned long)m_x86, m_size, m_symbol);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +221,7 @@ void Info::Print(FILE *fp)
 ////////////////////////////////////////////////////////////////////////////////
 
 InfoVector::InfoVector(const char *prefix)
+    : m_lookup(NULL)
 {
     strncpy(m_prefix, prefix, sizeof(m_prefix));
 #ifdef ENABLE_VTUNE
@@ -101,6 +249,13 @@ void InfoVector::map(uptr x86, u32 size, const char *symbol)
     u32 max_code_size = _1gb;
 #endif
 
+#ifdef ENABLE_PERF_JITDUMP
+    // The whole code reserves are mapped too (for the merged results), only dump the
+    // dispatchers and other small static zones.
+    if (size < 16 * _1kb)
+        jitdump_load(x86, size, symbol);
+#endif
+
     if (size < max_code_size) {
         m_v.emplace_back(x86, size, symbol);
 
@@ -129,6 +284,17 @@ void InfoVector::map(uptr x86, u32 size, u32 pc)
     m_v.emplace_back(x86, size, m_prefix, pc);
 #endif
 
+#ifdef ENABLE_PERF_JITDUMP
+    char name[256];
+    char symbol[200];
+    if (m_lookup && m_lookup(pc, symbol, sizeof(symbol)))
+        snprintf(name, sizeof(name), "%s_0x%08x %s", m_prefix, pc, symbol);
+    else
+        snprintf(name, sizeof(name), "%s_0x%08x", m_prefix, pc);
+
+    jitdump_load(x86, size, name);
+#endif
+
 #ifdef ENABLE_VTUNE
     iJIT_Method_Load_V2 ml;
 
@@ -161,8 +327,20 @@ void InfoVector::reset()
 // Global function
 ////////////////////////////////////////////////////////////////////////////////
 
+void jit_load(uptr x86, u32 size, const char *symbol)
+{
+#ifdef ENABLE_PERF_JITDUMP
+    jitdump_load(x86, size, symbol);
+#endif
+}
+
 void dump()
 {
+#ifdef ENABLE_PERF_JITDUMP
+    jitdump_flush();
+#endif
+
+#if defined(ProfileWithPerf) || defined(ENABLE_VTUNE)
     char file[256];
     snprintf(file, 250, "/tmp/perf-%d.map", getpid());
     FILE *fp = fopen(file, "w");
@@ -174,6 +352,7 @@ void dump()
 
     if (fp)
         fclose(fp);
+#endif
 }
 
 void dump_and_reset()
@@ -194,12 +373,15 @@ void dump_and_reset()
 
 InfoVector::InfoVector(const char *prefix)
     : m_vtune_id(0)
+    , m_lookup(NULL)
 {
 }
 void InfoVector::map(uptr x86, u32 size, const char *symbol) {}
 void InfoVector::map(uptr x86, u32 size, u32 pc) {}
 void InfoVector::reset() {}
 
+void jit_load(uptr x86, u32 size, const char *symbol) {}
+
 void dump() {}
 void dump_and_reset() {}
 
@@ -28,7 +28,9 @@ static long DoSysPageFaultExceptionFilter(EXCEPTION_POINTERS *eps)
     // Source_PageFault is a global variable with its own state information
     // so for now we lock this exception code unless someone can fix this better...
     Threading::ScopedLock lock(PageFault_Mutex);
-    Source_PageFault->Dispatch(PageFaultInfo((uptr)eps->ExceptionRecord->ExceptionInformation[1]));
+    // ExceptionInformation[0] is 1 for a write, 0 for a read (8 for DEP, treated as a read).
+    PageFaultAccess access = eps->ExceptionRecord->ExceptionInformation[0] == 1 ? PageFaultAccess_Write : PageFaultAccess_Read;
+    Source_PageFault->Dispatch(PageFaultInfo((uptr)eps->ExceptionRecord->ExceptionInformation[1], access));
     return Source_PageFault->WasHandled() ? EXCEPTION_CONTINUE_EXECUTION : EXCEPTION_CONTINUE_SEARCH;
 }
 
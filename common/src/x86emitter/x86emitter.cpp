@@ -1096,6 +1096,8 @@ __fi void xSAHF() { xWrite8(0x9e); }
 __fi void xSTC() { xWrite8(0xF9); }
 __fi void xCLC() { xWrite8(0xF8); }
 
+__fi void xRDTSC() { xWrite16(0x310f); }
+
 // NOP 1-byte
 __fi void xNOP() { xWrite8(0x90); }
 
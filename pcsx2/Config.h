@@ -195,7 +195,7 @@ struct Pcsx2Config
 			bool
 				Enabled:1,			// universal toggle for the profiler.
 				RecBlocks_EE:1,		// Enables per-block profiling for the EE recompiler [unimplemented]
-				RecBlocks_IOP:1,	// Enables per-block profiling for the IOP recompiler [unimplemented]
+				RecBlocks_IOP:1,	// Enables per-block profiling for the IOP recompiler
 				RecBlocks_VU0:1,	// Enables per-block profiling for the VU0 recompiler [unimplemented]
 				RecBlocks_VU1:1;	// Enables per-block profiling for the VU1 recompiler [unimplemented]
 		BITFIELD_END
@@ -301,6 +301,10 @@ struct Pcsx2Config
 		bool		FrameSkipEnable;
 		VsyncMode	VsyncEnable;
 
+		// paces fields to absolute deadlines with a nanosleep + spin wait instead of
+		// millisecond sleeps (steadier frame times, costs some cpu time spinning)
+		bool		PreciseFramePacing;
+
 		int		FramesToDraw;	// number of consecutive frames (fields) to render
 		int		FramesToSkip;	// number of consecutive frames (fields) to skip
 
@@ -322,6 +326,7 @@ struct Pcsx2Config
 				OpEqu( FrameSkipEnable )		&&
 				OpEqu( FrameLimitEnable )		&&
 				OpEqu( VsyncEnable )			&&
+				OpEqu( PreciseFramePacing )		&&
 
 				OpEqu( LimitScalar )			&&
 				OpEqu( FramerateNTSC )			&&
@@ -395,7 +400,8 @@ struct Pcsx2Config
 				IntcStat		:1,		// tells Pcsx2 to fast-forward through intc_stat waits.
 				WaitLoop		:1,		// enables constant loop detection and fast-forwarding
 				vuFlagHack		:1,		// microVU specific flag hack
-				vuThread        :1;		// Enable Threaded VU1
+				vuThread        :1,		// Enable Threaded VU1
+				iopThread       :1;		// Runs the IOP on its own thread (experimental, ini only)
 		BITFIELD_END
 
 		s8	EECycleRate;		// EE cycle rate selector (1.0, 1.5, 2.0)
@@ -464,6 +470,8 @@ struct Pcsx2Config
 		// enables simulated ejection of memory cards when loading savestates
 			McdEnableEjection	:1,
 			McdFolderAutoManage	:1,
+		// keeps a ring of delta savestates for rewinding (see SysCoreThread::Rewind)
+			EnableRewind		:1,
 
 			MultitapPort0_Enabled:1,
 			MultitapPort1_Enabled:1,
@@ -483,6 +491,9 @@ struct Pcsx2Config
 
 	wxFileName			BiosFilename;
 
+	uint				RewindInterval;		// vsyncs between rewind snapshots
+	uint				RewindSnapshots;	// number of rewind snapshots kept
+
 	Pcsx2Config();
 	void LoadSave( IniInterface& ini );
 
@@ -503,7 +514,9 @@ struct Pcsx2Config
 			OpEqu( Gamefixes )	&&
 			OpEqu( Profiler )	&&
 			OpEqu( Trace )		&&
-			OpEqu( BiosFilename );
+			OpEqu( BiosFilename )	&&
+			OpEqu( RewindInterval )	&&
+			OpEqu( RewindSnapshots );
 	}
 
 	bool operator !=( const Pcsx2Config& right ) const
@@ -527,6 +540,7 @@ TraceLogFilters&				SetTraceConfig();
 // ------------ CPU / Recompiler Options ---------------
 
 #define THREAD_VU1					(EmuConfig.Cpu.Recompiler.UseMicroVU1 && EmuConfig.Speedhacks.vuThread)
+#define THREAD_IOP					(EmuConfig.Speedhacks.iopThread)
 #define CHECK_MICROVU0				(EmuConfig.Cpu.Recompiler.UseMicroVU0)
 #define CHECK_MICROVU1				(EmuConfig.Cpu.Recompiler.UseMicroVU1)
 #define CHECK_EEREC					(EmuConfig.Cpu.Recompiler.EnableEE && GetCpuProviders().IsRecAvailable_EE())
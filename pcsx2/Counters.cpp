@@ -171,10 +171,15 @@ void rcntInit()
 #ifndef _WIN32
 #include <sys/time.h>
 #endif
+#include <chrono>
 
 static s64 m_iTicks=0;
 static u64 m_iStart=0;
 
+static void pacerReset();
+static void frameTimeReset();
+static double s_pacerPeriod = 0;	// nanoseconds per field, see frameLimitPrecise
+
 struct vSyncTimingInfo
 {
 	Fixed100 Framerate;		// frames per second (8 bit fixed)
@@ -386,12 +391,174 @@ u32 UpdateVSyncRate()
 
 	m_iStart = GetCPUTicks();
 
+	s_pacerPeriod = 500000000000.0 / (fpslimit * 1000).ToIntRounded();
+	pacerReset();
+
 	return (u32)m_iTicks;
 }
 
 void frameLimitReset()
 {
 	m_iStart = GetCPUTicks();
+
+	pacerReset();
+	frameTimeReset();
+}
+
+// --------------------------------------------------------------------------------------
+//  Precise frame pacing (GS.PreciseFramePacing)
+// --------------------------------------------------------------------------------------
+// Fields are released at base + n * period instead of "previous release + m_iTicks", so
+// neither the rounding of the period nor a late field shifts the ones after it.  The wait
+// is an absolute clock_nanosleep (a millisecond Sleep elsewhere) that wakes up a bit before
+// the deadline, and the remainder is spun on the clock.  The spin tail follows the wake-up
+// latency the OS actually delivers: it grows to the worst recent one and slowly decays.
+
+static u64 s_pacerBase = 0;			// nanoseconds
+static u64 s_pacerFrame = 0;		// fields released since s_pacerBase
+static s64 s_pacerSpin = 1000000;	// nanoseconds
+
+static const s64 PacerMinSpin = 100000;
+static const s64 PacerMaxSpin = 4000000;
+
+static u64 pacerNow()
+{
+#ifdef __linux__
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static void pacerSleepUntil(u64 target)
+{
+#ifdef __linux__
+	timespec ts;
+	ts.tv_sec = target / 1000000000;
+	ts.tv_nsec = target % 1000000000;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+#else
+	s64 left = (s64)(target - pacerNow());
+	if (left >= 1000000) Threading::Sleep(left / 1000000);
+#endif
+}
+
+static void pacerReset()
+{
+	s_pacerBase = pacerNow();
+	s_pacerFrame = 0;
+}
+
+static void frameLimitPrecise()
+{
+	u64 now = pacerNow();
+	u64 target = s_pacerBase + (u64)(++s_pacerFrame * s_pacerPeriod);
+	s64 delta = (s64)(target - now);
+
+	// Same as below: when we're way behind, restart the timeline rather than fast forward.
+	if (delta < -(s64)(s_pacerPeriod * 8))
+	{
+		pacerReset();
+		return;
+	}
+
+	if (delta <= 0) return;
+
+	if (delta > s_pacerSpin)
+	{
+		u64 wake = target - s_pacerSpin;
+		pacerSleepUntil(wake);
+
+		s64 late = (s64)(pacerNow() - wake);
+		s_pacerSpin = std::max(s_pacerSpin - s_pacerSpin / 64, late + late / 4 + 50000);
+		s_pacerSpin = std::min(std::max(s_pacerSpin, PacerMinSpin), PacerMaxSpin);
+	}
+
+	while ((s64)(target - pacerNow()) > 0)
+		Threading::SpinWait();
+}
+
+// --------------------------------------------------------------------------------------
+//  Frame time statistics
+// --------------------------------------------------------------------------------------
+// Histogram of the time between consecutive fields leaving the frame limiter, in 50us
+// buckets.  Every FrameTimeWindow fields the percentiles are published for frameTimeGetStats
+// (IPC MsgFrameTimes), and written to the console when precise pacing is enabled.
+
+static const uint FrameTimeBucketUs = 50;
+static const uint FrameTimeBuckets = 2048;		// the last bucket takes everything above ~100ms
+static const uint FrameTimeWindow = 600;
+
+static u32 s_frameTimeHist[FrameTimeBuckets];
+static u32 s_frameTimeCount = 0;
+static u32 s_frameTimeMax = 0;
+static u64 s_frameTimeLast = 0;
+
+static Mutex s_frameTimeLock;
+static FrameTimeStats s_frameTimeStats = {};
+
+static void frameTimeReset()
+{
+	// Don't count the pause (or reset) as a frame.
+	s_frameTimeLast = 0;
+}
+
+static u32 frameTimePercentile(u32 count, u32 percent)
+{
+	u32 rank = (count * percent + 99) / 100;
+	u32 sum = 0;
+
+	for (uint i = 0; i < FrameTimeBuckets; i++)
+	{
+		sum += s_frameTimeHist[i];
+		if (sum >= rank) return i * FrameTimeBucketUs + FrameTimeBucketUs / 2;
+	}
+
+	return (FrameTimeBuckets - 1) * FrameTimeBucketUs;
+}
+
+static void frameTimeRecord()
+{
+	u64 now = pacerNow();
+	u64 last = s_frameTimeLast;
+
+	s_frameTimeLast = now;
+
+	if (last == 0) return;
+
+	u32 us = (u32)std::min<u64>((now - last) / 1000, UINT32_MAX);
+
+	s_frameTimeHist[std::min(us / FrameTimeBucketUs, FrameTimeBuckets - 1)]++;
+	s_frameTimeMax = std::max(s_frameTimeMax, us);
+
+	if (++s_frameTimeCount < FrameTimeWindow) return;
+
+	FrameTimeStats stats;
+	stats.Frames = s_frameTimeCount;
+	stats.P50 = frameTimePercentile(s_frameTimeCount, 50);
+	stats.P99 = frameTimePercentile(s_frameTimeCount, 99);
+	stats.Max = s_frameTimeMax;
+
+	{
+		ScopedLock lock(s_frameTimeLock);
+		s_frameTimeStats = stats;
+	}
+
+	if (EmuConfig.GS.PreciseFramePacing)
+		Console.WriteLn(Color_Gray, "(FramePacing) Field times over %u fields: p50 %.2f ms, p99 %.2f ms, max %.2f ms (spin %.2f ms)",
+			stats.Frames, stats.P50 / 1000.0, stats.P99 / 1000.0, stats.Max / 1000.0, s_pacerSpin / 1000000.0);
+
+	memzero(s_frameTimeHist);
+	s_frameTimeCount = 0;
+	s_frameTimeMax = 0;
+}
+
+FrameTimeStats frameTimeGetStats()
+{
+	ScopedLock lock(s_frameTimeLock);
+	return s_frameTimeStats;
 }
 
 // Framelimiter - Measures the delta time between calls and stalls until a
@@ -402,6 +569,12 @@ static __fi void frameLimit()
 	// 999 means the user would rather just have framelimiting turned off...
 	if( !EmuConfig.GS.FrameLimitEnable ) return;
 
+	if( EmuConfig.GS.PreciseFramePacing )
+	{
+		frameLimitPrecise();
+		return;
+	}
+
 	u64 uExpectedEnd	= m_iStart + m_iTicks;
 	u64 iEnd			= GetCPUTicks();
 	s64 sDeltaTime		= iEnd - uExpectedEnd;
@@ -448,7 +621,13 @@ static __fi void VSyncStart(u32 sCycle)
 	Cpu->CheckExecutionState();
 
 	if(EmuConfig.Trace.Enabled && EmuConfig.Trace.EE.m_EnableAll)
+	{
 		SysTrace.EE.Counters.Write( "    ================  EE COUNTER VSYNC START (frame: %d)  ================", g_FrameCount );
+		SysTrace.EE.Counters.Write( "    Events fired last frame: EE %u, IOP %u", eeEventQueue.Fired, iopEventQueue.Fired );
+	}
+
+	eeEventQueue.Fired = 0;
+	iopEventQueue.Fired = 0;
 
 	// EE Profiling and Debug code.
 	// FIXME: should probably be moved to VsyncInThread, and handled
@@ -515,6 +694,7 @@ static __fi void VSyncEnd(u32 sCycle)
 		sioNextFrame();
 
 	frameLimit(); // limit FPS
+	frameTimeRecord();
 
 	// This doesn't seem to be needed here.  Games only seem to break with regard to the
 	// vsyncstart irq.
@@ -144,3 +144,15 @@ template< uint page > extern u16 rcntRead32( u32 mem );		// returns u16 by desig
 extern u32 UpdateVSyncRate();
 extern void frameLimitReset();
 
+// Time between consecutive fields leaving the frame limiter, over the last window of
+// fields (all in microseconds).
+struct FrameTimeStats
+{
+	u32 Frames;
+	u32 P50;
+	u32 P99;
+	u32 Max;
+};
+
+extern FrameTimeStats frameTimeGetStats();
+
@@ -20,6 +20,7 @@
 #include <cstdio>
 #include "../R5900.h"
 #include "../System.h"
+#include "../Memory.h"
 
 std::vector<BreakPoint> CBreakPoints::breakPoints_;
 u32 CBreakPoints::breakSkipFirstAt_ = 0;
@@ -57,6 +58,16 @@ MemCheck::MemCheck() :
 	numHits = 0;
 }
 
+bool MemCheck::UsesPageProtection() const
+{
+	if (result == 0)
+		return false;
+
+	u32 s = standardizeBreakpointAddress(start);
+	u32 e = standardizeBreakpointAddress(end);
+	return s < e && e <= Ps2MemSize::MainRam;
+}
+
 void MemCheck::Log(u32 addr, bool write, int size, u32 pc)
 {
 }
@@ -293,14 +304,16 @@ void CBreakPoints::AddMemCheck(u32 start, u32 end, MemCheckCondition cond, MemCh
 		check.cond = cond;
 		check.result = result;
 
+		size_t inlined = GetNumInlineMemchecks();
 		memChecks_.push_back(check);
-		Update();
+		Update(0, inlined != GetNumInlineMemchecks());
 	}
 	else
 	{
+		size_t inlined = GetNumInlineMemchecks();
 		memChecks_[mc].cond = (MemCheckCondition)(memChecks_[mc].cond | cond);
 		memChecks_[mc].result = (MemCheckResult)(memChecks_[mc].result | result);
-		Update();
+		Update(0, inlined != 0 || GetNumInlineMemchecks() != 0);
 	}
 }
 
@@ -312,8 +325,9 @@ void CBreakPoints::RemoveMemCheck(u32 start, u32 end)
 	size_t mc = FindMemCheck(start, end);
 	if (mc != INVALID_MEMCHECK)
 	{
+		bool inlined = !memChecks_[mc].UsesPageProtection();
 		memChecks_.erase(memChecks_.begin() + mc);
-		Update();
+		Update(0, inlined);
 	}
 }
 
@@ -322,9 +336,10 @@ void CBreakPoints::ChangeMemCheck(u32 start, u32 end, MemCheckCondition cond, Me
 	size_t mc = FindMemCheck(start, end);
 	if (mc != INVALID_MEMCHECK)
 	{
+		size_t inlined = GetNumInlineMemchecks();
 		memChecks_[mc].cond = cond;
 		memChecks_[mc].result = result;
-		Update();
+		Update(0, inlined != 0 || GetNumInlineMemchecks() != 0);
 	}
 }
 
@@ -335,8 +350,9 @@ void CBreakPoints::ClearAllMemChecks()
 
 	if (!memChecks_.empty())
 	{
+		size_t inlined = GetNumInlineMemchecks();
 		memChecks_.clear();
-		Update();
+		Update(0, inlined != 0);
 	}
 }
 
@@ -381,12 +397,23 @@ const std::vector<BreakPoint> CBreakPoints::GetBreakpoints()
 	return breakPoints_;
 }
 
+size_t CBreakPoints::GetNumInlineMemchecks()
+{
+	size_t count = 0;
+	for (auto it = memChecks_.begin(), end = memChecks_.end(); it != end; ++it)
+	{
+		if (it->result != 0 && !it->UsesPageProtection())
+			++count;
+	}
+	return count;
+}
+
 // including them earlier causes some ambiguities
 #include "App.h"
 #if wxUSE_GUI
 #include "Debugger/DisassemblyDialog.h"
 #endif
-void CBreakPoints::Update(u32 addr)
+void CBreakPoints::Update(u32 addr, bool flushCode)
 {
 	bool resume = false;
 	if (!r5900Debug.isCpuPaused())
@@ -398,8 +425,11 @@ void CBreakPoints::Update(u32 addr)
 //	if (addr != 0)
 //		Cpu->Clear(addr-4,8);
 //	else
+	if (flushCode)
 		SysClearExecutionCache();
 
+	mmap_UpdateMemchecks();
+
 	if (resume)
 		r5900Debug.resumeCpu();
 #ifndef __LIBRETRO__
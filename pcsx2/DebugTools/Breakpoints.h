@@ -100,6 +100,10 @@ struct MemCheck
 
 	void Log(u32 addr, bool write, int size, u32 pc);
 
+	// Checks on EE main ram are caught by protecting the host pages (see Memory.cpp),
+	// everything else still needs compares inlined into the memory ops.
+	bool UsesPageProtection() const;
+
 	bool operator == (const MemCheck &other) const {
 		return start == other.start && end == other.end;
 	}
@@ -142,8 +146,11 @@ public:
 	static const std::vector<MemCheck> GetMemChecks();
 	static const std::vector<BreakPoint> GetBreakpoints();
 	static size_t GetNumMemchecks() { return memChecks_.size(); }
+	static size_t GetNumInlineMemchecks();
 
-	static void Update(u32 addr = 0);
+	// flushCode - clear the recompiler cache.  Memchecks that only use page protection
+	// don't need it.
+	static void Update(u32 addr = 0, bool flushCode = true);
 
 	static void SetBreakpointTriggered(bool b) { breakpointTriggered_ = b; };
 	static bool GetBreakpointTriggered() { return breakpointTriggered_; };
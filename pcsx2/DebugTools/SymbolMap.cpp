@@ -26,6 +26,62 @@ SymbolMap symbolMap;
 
 #define ARRAY_SIZE(x) (sizeof((x))/sizeof(*(x)))
 
+// Index of the last key <= value, or -1.  The loop count only depends on the array size
+// and the compare compiles to a cmov, so there are no mispredicted branches.
+static int FindFloor(const std::vector<u32>& keys, u32 value) {
+	if (keys.empty() || value < keys[0])
+		return -1;
+
+	const u32* base = keys.data();
+	size_t n = keys.size();
+	while (n > 1) {
+		size_t half = n / 2;
+		base = (base[half] <= value) ? base + half : base;
+		n -= half;
+	}
+	return (int)(base - keys.data());
+}
+
+static int FindExact(const std::vector<u32>& keys, u32 value) {
+	int i = FindFloor(keys, value);
+	return (i >= 0 && keys[i] == value) ? i : -1;
+}
+
+std::shared_ptr<const SymbolMap::ActiveSymbols> SymbolMap::GetActiveSymbols() const {
+	if (m_dirty.load(std::memory_order_acquire)) {
+		std::lock_guard<std::recursive_mutex> guard(m_lock);
+		if (m_dirty.load(std::memory_order_relaxed)) {
+			auto active = std::make_shared<ActiveSymbols>();
+
+			active->functionStarts.reserve(activeFunctions.size());
+			active->functions.reserve(activeFunctions.size());
+			for (auto it = activeFunctions.begin(); it != activeFunctions.end(); ++it) {
+				active->functionStarts.push_back(it->first);
+				active->functions.push_back(it->second);
+			}
+
+			active->labelAddrs.reserve(activeLabels.size());
+			active->labels.reserve(activeLabels.size());
+			for (auto it = activeLabels.begin(); it != activeLabels.end(); ++it) {
+				active->labelAddrs.push_back(it->first);
+				active->labels.push_back(it->second);
+			}
+
+			active->dataStarts.reserve(activeData.size());
+			active->data.reserve(activeData.size());
+			for (auto it = activeData.begin(); it != activeData.end(); ++it) {
+				active->dataStarts.push_back(it->first);
+				active->data.push_back(it->second);
+			}
+
+			std::atomic_store(&m_active, std::shared_ptr<const ActiveSymbols>(active));
+			m_dirty.store(false, std::memory_order_release);
+		}
+	}
+
+	return std::atomic_load(&m_active);
+}
+
 void SymbolMap::SortSymbols() {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	AssignFunctionIndices();
@@ -41,6 +97,7 @@ void SymbolMap::Clear() {
 	activeData.clear();
 	activeModuleEnds.clear();
 	modules.clear();
+	Invalidate();
 }
 
 
@@ -103,10 +160,10 @@ bool SymbolMap::LoadNocashSym(const char *filename) {
 }
 
 SymbolType SymbolMap::GetSymbolType(u32 address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	if (activeFunctions.find(address) != activeFunctions.end())
+	const auto active = GetActiveSymbols();
+	if (FindExact(active->functionStarts, address) >= 0)
 		return ST_FUNCTION;
-	if (activeData.find(address) != activeData.end())
+	if (FindExact(active->dataStarts, address) >= 0)
 		return ST_DATA;
 	return ST_NONE;
 }
@@ -156,15 +213,17 @@ bool SymbolMap::GetSymbolInfo(SymbolInfo *info, u32 address, SymbolType symmask)
 }
 
 u32 SymbolMap::GetNextSymbolAddress(u32 address, SymbolType symmask) {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	const auto functionEntry = symmask & ST_FUNCTION ? activeFunctions.upper_bound(address) : activeFunctions.end();
-	const auto dataEntry = symmask & ST_DATA ? activeData.upper_bound(address) : activeData.end();
+	const auto active = GetActiveSymbols();
+	const auto& functionStarts = active->functionStarts;
+	const auto& dataStarts = active->dataStarts;
+	const size_t functionEntry = symmask & ST_FUNCTION ? FindFloor(functionStarts, address) + 1 : functionStarts.size();
+	const size_t dataEntry = symmask & ST_DATA ? FindFloor(dataStarts, address) + 1 : dataStarts.size();
 
-	if (functionEntry == activeFunctions.end() && dataEntry == activeData.end())
+	if (functionEntry == functionStarts.size() && dataEntry == dataStarts.size())
 		return INVALID_ADDRESS;
 
-	u32 funcAddress = (functionEntry != activeFunctions.end()) ? functionEntry->first : 0xFFFFFFFF;
-	u32 dataAddress = (dataEntry != activeData.end()) ? dataEntry->first : 0xFFFFFFFF;
+	u32 funcAddress = (functionEntry != functionStarts.size()) ? functionStarts[functionEntry] : 0xFFFFFFFF;
+	u32 dataAddress = (dataEntry != dataStarts.size()) ? dataStarts[dataEntry] : 0xFFFFFFFF;
 
 	if (funcAddress <= dataAddress)
 		return funcAddress;
@@ -173,20 +232,14 @@ u32 SymbolMap::GetNextSymbolAddress(u32 address, SymbolType symmask) {
 }
 
 std::string SymbolMap::GetDescription(unsigned int address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	const char* labelName = NULL;
-
-	u32 funcStart = GetFunctionStart(address);
-	if (funcStart != INVALID_ADDRESS) {
-		labelName = GetLabelName(funcStart);
-	} else {
-		u32 dataStart = GetDataStart(address);
-		if (dataStart != INVALID_ADDRESS)
-			labelName = GetLabelName(dataStart);
-	}
+	const auto active = GetActiveSymbols();
+	u32 start = GetFunctionStart(address);
+	if (start == INVALID_ADDRESS)
+		start = GetDataStart(address);
 
-	if (labelName != NULL)
-		return labelName;
+	int label = start != INVALID_ADDRESS ? FindExact(active->labelAddrs, start) : -1;
+	if (label >= 0)
+		return active->labels[label].name;
 
 	char descriptionTemp[256];
 	sprintf(descriptionTemp, "(%08x)", address);
@@ -364,56 +417,41 @@ void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleI
 		}
 	}
 
+	Invalidate();
 	AddLabel(name, address, moduleIndex);
 }
 
 u32 SymbolMap::GetFunctionStart(u32 address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeFunctions.upper_bound(address);
-	if (it == activeFunctions.end()) {
-		// check last element
-		auto rit = activeFunctions.rbegin();
-		if (rit != activeFunctions.rend()) {
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no function that contains this address
+	const auto active = GetActiveSymbols();
+	int i = FindFloor(active->functionStarts, address);
+	if (i < 0)
 		return INVALID_ADDRESS;
-	}
 
-	if (it != activeFunctions.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
-		if (start <= address && start+size > address)
-			return start;
-	}
+	// only the closest function below is checked, there's no function that contains this
+	// address if it ends before it
+	u32 start = active->functionStarts[i];
+	if (start + active->functions[i].size > address)
+		return start;
 
 	return INVALID_ADDRESS;
 }
 
 u32 SymbolMap::GetFunctionSize(u32 startAddress) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeFunctions.find(startAddress);
-	if (it == activeFunctions.end())
+	const auto active = GetActiveSymbols();
+	int i = FindExact(active->functionStarts, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
 
-	return it->second.size;
+	return active->functions[i].size;
 }
 
 int SymbolMap::GetFunctionNum(u32 address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	u32 start = GetFunctionStart(address);
-	if (start == INVALID_ADDRESS)
+	const auto active = GetActiveSymbols();
+	int i = FindFloor(active->functionStarts, address);
+	if (i < 0 || active->functionStarts[i] + active->functions[i].size <= address)
 		return INVALID_ADDRESS;
 
-	auto it = activeFunctions.find(start);
-	if (it == activeFunctions.end())
-		return INVALID_ADDRESS;
-
-	return it->second.index;
+	return active->functions[i].index;
 }
 
 void SymbolMap::AssignFunctionIndices() {
@@ -427,6 +465,7 @@ void SymbolMap::AssignFunctionIndices() {
 			it->second.index = index++;
 		}
 	}
+	Invalidate();
 }
 
 void SymbolMap::UpdateActiveSymbols() {
@@ -514,6 +553,7 @@ bool SymbolMap::RemoveFunction(u32 startAddress, bool removeName) {
 		}
 	}
 
+	Invalidate();
 	return true;
 }
 
@@ -559,6 +599,7 @@ void SymbolMap::AddLabel(const char* name, u32 address, int moduleIndex) {
 			activeLabels.insert(std::make_pair(address, label));
 		}
 	}
+	Invalidate();
 }
 
 void SymbolMap::SetLabelName(const char* name, u32 address, bool updateImmediately) {
@@ -601,11 +642,11 @@ const char *SymbolMap::GetLabelNameRel(u32 relAddress, int moduleIndex) const {
 }
 
 std::string SymbolMap::GetLabelString(u32 address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	const char *label = GetLabelName(address);
-	if (label == NULL)
+	const auto active = GetActiveSymbols();
+	int i = FindExact(active->labelAddrs, address);
+	if (i < 0)
 		return "";
-	return label;
+	return active->labels[i].name;
 }
 
 bool SymbolMap::GetLabelValue(const char* name, u32& dest) {
@@ -662,50 +703,39 @@ void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
 			activeData.insert(std::make_pair(address, entry));
 		}
 	}
+	Invalidate();
 }
 
 u32 SymbolMap::GetDataStart(u32 address) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.upper_bound(address);
-	if (it == activeData.end())
-	{
-		// check last element
-		auto rit = activeData.rbegin();
-
-		if (rit != activeData.rend())
-		{
-			u32 start = rit->first;
-			u32 size = rit->second.size;
-			if (start <= address && start+size > address)
-				return start;
-		}
-		// otherwise there's no data that contains this address
+	const auto active = GetActiveSymbols();
+	int i = FindFloor(active->dataStarts, address);
+	if (i < 0)
 		return INVALID_ADDRESS;
-	}
 
-	if (it != activeData.begin()) {
-		it--;
-		u32 start = it->first;
-		u32 size = it->second.size;
-		if (start <= address && start+size > address)
-			return start;
-	}
+	u32 start = active->dataStarts[i];
+	if (start + active->data[i].size > address)
+		return start;
 
 	return INVALID_ADDRESS;
 }
 
 u32 SymbolMap::GetDataSize(u32 startAddress) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	const auto active = GetActiveSymbols();
+	int i = FindExact(active->dataStarts, startAddress);
+	if (i < 0)
 		return INVALID_ADDRESS;
-	return it->second.size;
+	return active->data[i].size;
 }
 
 DataType SymbolMap::GetDataType(u32 startAddress) const {
-	std::lock_guard<std::recursive_mutex> guard(m_lock);
-	auto it = activeData.find(startAddress);
-	if (it == activeData.end())
+	const auto active = GetActiveSymbols();
+	int i = FindExact(active->dataStarts, startAddress);
+	if (i < 0)
 		return DATATYPE_NONE;
-	return it->second.type;
+	return active->data[i].type;
+}
+
+bool SymbolMap::IsEmpty() const {
+	const auto active = GetActiveSymbols();
+	return active->functionStarts.empty() && active->labelAddrs.empty() && active->dataStarts.empty();
 }
@@ -20,6 +20,8 @@
 #include <map>
 #include <string>
 #include <mutex>
+#include <memory>
+#include <atomic>
 
 #include "Pcsx2Types.h"
 
@@ -55,7 +57,7 @@ enum DataType {
 
 class SymbolMap {
 public:
-	SymbolMap() {}
+	SymbolMap() : m_dirty(false), m_active(std::make_shared<ActiveSymbols>()) {}
 	void Clear();
 	void SortSymbols();
 
@@ -95,9 +97,10 @@ public:
 	static const u32 INVALID_ADDRESS = (u32)-1;
 
 	void UpdateActiveSymbols();
-	bool IsEmpty() const { return activeFunctions.empty() && activeLabels.empty() && activeData.empty(); };
+	bool IsEmpty() const;
 private:
 	void AssignFunctionIndices();
+	void Invalidate() { m_dirty.store(true, std::memory_order_release); }
 	const char *GetLabelName(u32 address) const;
 	const char *GetLabelNameRel(u32 relAddress, int moduleIndex) const;
 
@@ -146,6 +149,24 @@ private:
 	std::vector<ModuleEntry> modules;
 
 	mutable std::recursive_mutex m_lock;
+
+	// Immutable, sorted array copy of the active symbols used by the per-address lookups
+	// (disassembly view, stack walker, profilers).  It is rebuilt by the first lookup after
+	// a change, readers only take m_lock for that rebuild.  The start addresses are kept
+	// apart from the entries so the search only walks a dense u32 array.
+	struct ActiveSymbols {
+		std::vector<u32> functionStarts;
+		std::vector<FunctionEntry> functions;
+		std::vector<u32> labelAddrs;
+		std::vector<LabelEntry> labels;
+		std::vector<u32> dataStarts;
+		std::vector<DataEntry> data;
+	};
+
+	std::shared_ptr<const ActiveSymbols> GetActiveSymbols() const;
+
+	mutable std::atomic<bool> m_dirty;
+	mutable std::shared_ptr<const ActiveSymbols> m_active;
 };
 
 extern SymbolMap symbolMap;
@@ -0,0 +1,147 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2010  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+// --------------------------------------------------------------------------------------
+//  EventQueue
+// --------------------------------------------------------------------------------------
+// Min-heap of the pending 'pcsx2 interrupts' of one cpu (the bits of cpuRegs.interrupt or
+// psxRegs.interrupt), keyed on the cycle each one is due.  The event tests read the nearest
+// deadline in O(1) and only dispatch the events that are actually due, instead of testing
+// every channel on every event test.
+//
+// The interrupt bits and the sCycle/eCycle arrays stay the authoritative state: they are
+// saved in savestates, and a few DMA handlers clear bits (or postpone eCycle) directly.  The
+// owner validates the top entry against them before trusting it, see R5900.cpp/R3000A.cpp.
+//
+// Deadlines are compared relative to each other ((s32)(a - b)), so the cycle counters can
+// wrap as long as all pending events are less than 2^31 cycles apart.
+//
+class EventQueue
+{
+protected:
+	u32		m_deadline[32];		// due cycle of each queued event
+	u8		m_heap[32];			// event ids, m_heap[0] is the nearest deadline
+	u8		m_pos[32];			// position of each queued event in m_heap
+	uint	m_count;
+	u32		m_queued;			// bitmask of the queued event ids
+
+public:
+	u32		Fired;				// events dispatched, cleared every frame (profiling only)
+
+public:
+	EventQueue() { Reset(); }
+
+	void Reset()
+	{
+		m_count = 0;
+		m_queued = 0;
+		Fired = 0;
+	}
+
+	bool IsEmpty() const { return m_count == 0; }
+	u32 GetQueued() const { return m_queued; }
+
+	uint Top() const { return m_heap[0]; }
+	u32 TopDeadline() const { return m_deadline[m_heap[0]]; }
+
+	// Queues event n, or moves it if it is already queued.
+	void Schedule( uint n, u32 deadline )
+	{
+		pxAssume( n < 32 );
+
+		if( m_queued & (1 << n) )
+		{
+			s32 delta = (s32)(deadline - m_deadline[n]);
+			m_deadline[n] = deadline;
+
+			if( delta < 0 ) SiftUp( m_pos[n] );
+			else if( delta > 0 ) SiftDown( m_pos[n] );
+		}
+		else
+		{
+			m_queued |= 1 << n;
+			m_deadline[n] = deadline;
+			m_heap[m_count] = n;
+			m_pos[n] = m_count;
+			SiftUp( m_count++ );
+		}
+	}
+
+	void Remove( uint n )
+	{
+		pxAssume( n < 32 );
+
+		if( !(m_queued & (1 << n)) ) return;
+
+		m_queued &= ~(1 << n);
+
+		uint i = m_pos[n];
+		uint last = m_heap[--m_count];
+
+		if( i == m_count ) return;
+
+		m_heap[i] = last;
+		m_pos[last] = i;
+
+		if( i > 0 && Before( last, m_heap[(i - 1) / 2] ) ) SiftUp( i );
+		else SiftDown( i );
+	}
+
+protected:
+	bool Before( uint a, uint b ) const
+	{
+		return (s32)(m_deadline[a] - m_deadline[b]) < 0;
+	}
+
+	void Place( uint i, uint n )
+	{
+		m_heap[i] = n;
+		m_pos[n] = i;
+	}
+
+	void SiftUp( uint i )
+	{
+		uint n = m_heap[i];
+
+		while( i > 0 )
+		{
+			uint parent = (i - 1) / 2;
+			if( !Before( n, m_heap[parent] ) ) break;
+			Place( i, m_heap[parent] );
+			i = parent;
+		}
+
+		Place( i, n );
+	}
+
+	void SiftDown( uint i )
+	{
+		uint n = m_heap[i];
+
+		for(;;)
+		{
+			uint child = i * 2 + 1;
+			if( child >= m_count ) break;
+			if( child + 1 < m_count && Before( m_heap[child + 1], m_heap[child] ) ) child++;
+			if( !Before( m_heap[child], n ) ) break;
+			Place( i, m_heap[child] );
+			i = child;
+		}
+
+		Place( i, n );
+	}
+};
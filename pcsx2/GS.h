@@ -292,6 +292,7 @@ enum MTGS_RingCommand
 ,	GS_RINGTYPE_MODECHANGE		// for issued mode changes.
 ,	GS_RINGTYPE_CRC
 ,	GS_RINGTYPE_GSPACKET
+,	GS_RINGTYPE_GSPACKET_PINNED	// path 3 packet read in place from pinned ee main ram
 ,	GS_RINGTYPE_MTVU_GSPACKET
 ,	GS_RINGTYPE_INIT_READ_FIFO1
 ,	GS_RINGTYPE_INIT_READ_FIFO2
@@ -16,6 +16,16 @@
 #include "PrecompiledHeader.h"
 #include "GameDatabase.h"
 
+#include <wx/ffile.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 BaseGameDatabaseImpl::BaseGameDatabaseImpl()
 	: gHash( 9900 )
 	, m_baseKey( L"Serial" )
@@ -28,8 +38,7 @@ bool BaseGameDatabaseImpl::findGame(Game_Data& dest, const wxString& id) {
 
 	GameDataHash::const_iterator iter( gHash.find(id) );
 	if( iter == gHash.end() ) {
-		dest.clear();
-		return false;
+		return m_index.FindGame(dest, id);
 	}
 	dest = iter->second;
 	return true;
@@ -74,3 +83,245 @@ void Game_Data::writeString(const wxString& key, const wxString& value) {
 		kList.push_back(key_pair(key, value));
 	}
 }
+
+// --------------------------------------------------------------------------------------
+//  GameDatabaseIndex  (implementations)
+// --------------------------------------------------------------------------------------
+GameDatabaseIndex::GameDatabaseIndex()
+{
+	m_data		= NULL;
+	m_size		= 0;
+	m_header	= NULL;
+	m_games		= NULL;
+	m_pairs		= NULL;
+	m_strings	= NULL;
+}
+
+GameDatabaseIndex::~GameDatabaseIndex()
+{
+	Close();
+}
+
+// 64 bit FNV-1a, fed 8 bytes at a time.  Only used to detect changes to the source
+// database, so it doesn't need to be anything fancy, just fast.
+u64 GameDatabaseIndex::HashSource( const void* data, size_t size )
+{
+	const u8* src = (const u8*)data;
+	u64 hash = 0xcbf29ce484222325ULL;
+
+	for (; size >= 8; size -= 8, src += 8)
+	{
+		u64 word;
+		memcpy(&word, src, 8);
+		hash = (hash ^ word) * 0x100000001b3ULL;
+	}
+	for (; size; --size, ++src)
+		hash = (hash ^ *src) * 0x100000001b3ULL;
+
+	return hash;
+}
+
+bool GameDatabaseIndex::Open( const wxString& filename, u64 sourceHash )
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(filename.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	HANDLE mapping = NULL;
+	if (GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG)sizeof(Header))
+		mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (!mapping)
+		return false;
+
+	m_data = (const u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (!m_data)
+		return false;
+	m_size = (size_t)size.QuadPart;
+#else
+	int fd = open(filename.utf8_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	const off_t size = lseek(fd, 0, SEEK_END);
+	void* ptr = MAP_FAILED;
+	if (size >= (off_t)sizeof(Header))
+		ptr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (ptr == MAP_FAILED)
+		return false;
+
+	m_data = (const u8*)ptr;
+	m_size = (size_t)size;
+#endif
+
+	// Validate everything up front, so lookups don't have to.
+	const Header* header = (const Header*)m_data;
+	const u64 tablesSize = sizeof(Header) + (u64)header->gameCount * sizeof(GameRecord) + (u64)header->pairCount * sizeof(PairRecord);
+
+	if (header->magic != IndexMagic || header->version != IndexVersion || header->sourceHash != sourceHash ||
+		tablesSize + header->stringsSize != m_size)
+	{
+		Close();
+		return false;
+	}
+
+	m_header	= header;
+	m_games		= (const GameRecord*)(m_data + sizeof(Header));
+	m_pairs		= (const PairRecord*)(m_games + header->gameCount);
+	m_strings	= (const char*)(m_pairs + header->pairCount);
+
+	for (u32 i = 0; i < header->gameCount; ++i)
+	{
+		const GameRecord& game = m_games[i];
+		if ((u64)game.serialOffset + game.serialLength > header->stringsSize ||
+			(u64)game.firstPair + game.pairCount > header->pairCount)
+		{
+			Close();
+			return false;
+		}
+	}
+	for (u32 i = 0; i < header->pairCount; ++i)
+	{
+		const PairRecord& pair = m_pairs[i];
+		if ((u64)pair.keyOffset + pair.keyLength > header->stringsSize ||
+			(u64)pair.valueOffset + pair.valueLength > header->stringsSize)
+		{
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void GameDatabaseIndex::Close()
+{
+	if (m_data)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+#else
+		munmap((void*)m_data, m_size);
+#endif
+	}
+
+	m_data		= NULL;
+	m_size		= 0;
+	m_header	= NULL;
+	m_games		= NULL;
+	m_pairs		= NULL;
+	m_strings	= NULL;
+}
+
+bool GameDatabaseIndex::FindGame( Game_Data& dest, const wxString& id ) const
+{
+	dest.clear();
+	if (!m_header)
+		return false;
+
+	const wxScopedCharBuffer key(id.utf8_str());
+	const size_t keylen = key.length();
+
+	// Binary search on the raw UTF-8 bytes of the serial; Write() sorts the same way.
+	u32 lo = 0, hi = m_header->gameCount;
+	while (lo < hi)
+	{
+		const u32 mid = (lo + hi) / 2;
+		const GameRecord& game = m_games[mid];
+
+		int cmp = memcmp(m_strings + game.serialOffset, key.data(), std::min<size_t>(game.serialLength, keylen));
+		if (cmp == 0)
+			cmp = (game.serialLength < keylen) ? -1 : (game.serialLength > keylen) ? 1 : 0;
+
+		if (cmp < 0)
+			lo = mid + 1;
+		else if (cmp > 0)
+			hi = mid;
+		else
+		{
+			dest.id = GetString(game.serialOffset, game.serialLength);
+			dest.kList.reserve(game.pairCount);
+			for (u32 i = 0; i < game.pairCount; ++i)
+			{
+				const PairRecord& pair = m_pairs[game.firstPair + i];
+				dest.kList.push_back(key_pair(GetString(pair.keyOffset, pair.keyLength), GetString(pair.valueOffset, pair.valueLength)));
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GameDatabaseIndex::Write( const wxString& filename, u64 sourceHash, const GameDataHash& games )
+{
+	std::vector<std::pair<std::string, const Game_Data*>> sorted;
+	sorted.reserve(games.size());
+	for (const auto& game : games)
+		sorted.emplace_back(std::string(game.first.utf8_str()), &game.second);
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, const Game_Data*>& a, const std::pair<std::string, const Game_Data*>& b) {
+		return a.first < b.first;
+	});
+
+	std::vector<GameRecord> gameRecords;
+	std::vector<PairRecord> pairRecords;
+	std::string strings;
+	gameRecords.reserve(sorted.size());
+
+	auto addString = [&strings](const std::string& str, u32& offset, u32& length) {
+		offset = (u32)strings.size();
+		length = (u32)str.size();
+		strings += str;
+	};
+
+	for (const auto& game : sorted)
+	{
+		GameRecord record;
+		addString(game.first, record.serialOffset, record.serialLength);
+		record.firstPair = (u32)pairRecords.size();
+		record.pairCount = (u32)game.second->kList.size();
+
+		for (const key_pair& kp : game.second->kList)
+		{
+			PairRecord pair;
+			addString(std::string(kp.key.utf8_str()), pair.keyOffset, pair.keyLength);
+			addString(std::string(kp.value.utf8_str()), pair.valueOffset, pair.valueLength);
+			pairRecords.push_back(pair);
+		}
+		gameRecords.push_back(record);
+	}
+
+	Header header = {};
+	header.magic		= IndexMagic;
+	header.version		= IndexVersion;
+	header.sourceHash	= sourceHash;
+	header.gameCount	= (u32)gameRecords.size();
+	header.pairCount	= (u32)pairRecords.size();
+	header.stringsSize	= (u32)strings.size();
+
+	// Write to a temporary file and rename it into place, so that a concurrently running
+	// instance never maps a half-written index.
+	const wxString tempname(filename + L".tmp");
+	{
+		wxFFile file(tempname, L"wb");
+		if (!file.IsOpened())
+			return false;
+
+		bool ok = file.Write(&header, sizeof(header)) == sizeof(header);
+		ok = ok && file.Write(gameRecords.data(), gameRecords.size() * sizeof(GameRecord)) == gameRecords.size() * sizeof(GameRecord);
+		ok = ok && file.Write(pairRecords.data(), pairRecords.size() * sizeof(PairRecord)) == pairRecords.size() * sizeof(PairRecord);
+		ok = ok && file.Write(strings.data(), strings.size()) == strings.size();
+		if (!file.Close() || !ok)
+		{
+			wxRemoveFile(tempname);
+			return false;
+		}
+	}
+
+	return wxRenameFile(tempname, filename, true);
+}
@@ -138,6 +138,84 @@ public:
 
 using GameDataHash = std::unordered_map<wxString, Game_Data, StringHash>;
 
+// --------------------------------------------------------------------------------------
+//  GameDatabaseIndex
+// --------------------------------------------------------------------------------------
+// Compact binary form of a parsed game database.  The index file is memory-mapped as-is:
+// games are sorted by serial and found with a binary search, and only the games that are
+// actually looked up get converted back into Game_Data.  The index records a hash of the
+// text database it was built from, so a stale index is simply rejected by Open().
+//
+// File layout: Header, GameRecord[gameCount], PairRecord[pairCount], UTF-8 string data.
+//
+class GameDatabaseIndex
+{
+	DeclareNoncopyableObject( GameDatabaseIndex );
+
+public:
+	static const u32 IndexMagic		= 0x42444750;	// "PGDB"
+	static const u32 IndexVersion	= 1;
+
+	struct Header
+	{
+		u32 magic;
+		u32 version;
+		u64 sourceHash;
+		u32 gameCount;
+		u32 pairCount;
+		u32 stringsSize;
+		u32 reserved;
+	};
+
+	struct GameRecord
+	{
+		u32 serialOffset;
+		u32 serialLength;
+		u32 firstPair;
+		u32 pairCount;
+	};
+
+	struct PairRecord
+	{
+		u32 keyOffset;
+		u32 keyLength;
+		u32 valueOffset;
+		u32 valueLength;
+	};
+
+protected:
+	const u8*			m_data;
+	size_t				m_size;
+
+	const Header*		m_header;
+	const GameRecord*	m_games;
+	const PairRecord*	m_pairs;
+	const char*			m_strings;
+
+public:
+	GameDatabaseIndex();
+	virtual ~GameDatabaseIndex();
+
+	// Maps the given index file, returns false if it doesn't exist, is malformed, or
+	// was built from a different source database.
+	bool Open( const wxString& filename, u64 sourceHash );
+	void Close();
+
+	bool IsOpen() const { return m_data != NULL; }
+	u32 GetGameCount() const { return m_header ? m_header->gameCount : 0; }
+
+	bool FindGame( Game_Data& dest, const wxString& id ) const;
+
+	static bool Write( const wxString& filename, u64 sourceHash, const GameDataHash& games );
+	static u64 HashSource( const void* data, size_t size );
+
+protected:
+	wxString GetString( u32 offset, u32 length ) const
+	{
+		return wxString::FromUTF8( m_strings + offset, length );
+	}
+};
+
 // --------------------------------------------------------------------------------------
 //  BaseGameDatabaseImpl 
 // --------------------------------------------------------------------------------------
@@ -145,6 +223,7 @@ class BaseGameDatabaseImpl : public IGameDatabase
 {
 protected:
 	GameDataHash	gHash;			// hash table of game serials matched to their gList indexes!
+	GameDatabaseIndex m_index;		// games loaded from a prebuilt index, searched after gHash
 	wxString		m_baseKey;
 
 public:
@@ -17,6 +17,7 @@
 
 #define COPY_GS_PACKET_TO_MTGS 0
 #define PRINT_GIF_PACKET 0
+#define PIN_GIF_PATH3_DMA 1			// large path 3 packets are read by the mtgs from ee ram
 
 //#define GUNIT_LOG DevCon.WriteLn
 #define GUNIT_LOG(...) do {} while(0)
@@ -520,6 +520,8 @@ struct Gif_Unit {
 		if (tranType == GIF_TRANS_DMA) {
 			if(!CanDoPath3())   { if (!Path3Masked()) stat.P3Q = 1; return 0; } // DMA Stall
 			//if (stat.P2Q) DevCon.WriteLn("P2Q while path 3");
+			if (PIN_GIF_PATH3_DMA && size >= Path3PinMinSize && TransferPath3Pinned(pMem, size))
+				return size;
 		}
 		if (tranType == GIF_TRANS_XGKICK) {
 			if(!CanDoPath1())   { stat.P1Q = 1; } // We always buffer path1 packets
@@ -536,6 +538,64 @@ struct Gif_Unit {
 		return size;
 	}
 
+	// Path 3 DMA of a single complete GS packet (usually a texture upload) while the other
+	// paths are idle: rather than copying it into the path buffer, the ee ram holding it is
+	// pinned and the MTGS reads it from there (see mmap_PinRamRange).  This does the same as
+	// Execute() would do for such a packet.  Returns false if the packet doesn't qualify, or
+	// couldn't be pinned, and has to go through the path buffer.
+	static const u32 Path3PinMinSize = _64kb;
+
+	bool TransferPath3Pinned(u8* pMem, u32 size) {
+		Gif_Path& path = gifPath[GIF_PATH_3];
+		if (PRINT_GIF_PACKET || path.hasDataRemaining() || path.gsPack.size || path.gifTag.isValid) return false;
+		if (gsSIGNAL.queued || checkPaths(1,1,0,true)) return false;
+
+		// The DMA has to end with the EOP of the packet, and the packet can't stall on a SIGNAL
+		for (u32 offset = 0;;) {
+			if (offset + 16 > size) return false;
+			Gif_Tag gifTag(&pMem[offset], true);
+			offset += 16;
+			if (gifTag.hasAD) {
+				for (u32 i = 0; i < gifTag.len; i += 16, gifTag.packedStep()) {
+					if (offset + i + 16 > size) return false;
+					if (gifTag.curReg() == GIF_REG_A_D && pMem[offset + i + 8] == 0x60) return false;
+				}
+			}
+			offset += gifTag.len;
+			if (gifTag.tag.EOP) {
+				if (offset != size) return false;
+				break;
+			}
+		}
+
+		int pin = mmap_PinRamRange(pMem, size);
+		if (pin < 0) return false;
+
+		if (!stat.APATH) {
+			stat.APATH = 3;
+			stat.P3Q   = 0;
+			stat.IP3   = 0;
+		}
+		stat.OPH       = 1;
+		path.dmaRewind = 0;
+
+		for (u32 offset = 0; offset < size;) {
+			Gif_Tag gifTag(&pMem[offset], true);
+			offset += 16;
+			if (gifTag.hasAD) {
+				for (u32 i = 0; i < gifTag.len; i += 16, gifTag.packedStep()) {
+					if (gifTag.curReg() == GIF_REG_A_D) Gif_HandlerAD(&pMem[offset + i]);
+				}
+			}
+			offset += gifTag.len;
+		}
+
+		path.state = GIF_PATH_WAIT;
+		GetMTGS().SendSimplePacket(GS_RINGTYPE_GSPACKET_PINNED, pin, 0, 0);
+		Gif_FinishIRQ();
+		return true;
+	}
+
 	// Checks path activity for the given paths
 	// Returns an int with a bit enabled if the corresponding
 	// path is not finished (needs more data/processing for an EOP)
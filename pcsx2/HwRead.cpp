@@ -90,6 +90,9 @@ mem32_t __fastcall _hwRead32(u32 mem)
 				return psHu32(INTC_STAT);
 			}
 
+			// SBUS registers are shared with the IOP
+			if ((mem & 0xff00) == 0xf200) iopThreadJoin();
+
 			// todo: psx mode: this is new
 			if (((mem & 0x1FFFFFFF) >= EEMemoryMap::SBUS_PS1_Start) && ((mem & 0x1FFFFFFF) < EEMemoryMap::SBUS_PS1_End)) {
 				return PGIFr((mem & 0x1FFFFFFF));
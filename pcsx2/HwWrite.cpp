@@ -139,6 +139,9 @@ void __fastcall _hwWrite32( u32 mem, u32 value )
 
 		case 0x0f:
 		{
+			// SBUS registers are shared with the IOP
+			if ((mem & 0xff00) == 0xf200) iopThreadJoin();
+
 			switch( HELPSWITCH(mem) )
 			{
 				mcase(INTC_STAT):
@@ -32,16 +32,59 @@
 #include <sys/socket.h>
 #include <sys/un.h>
 #endif
+#ifdef __linux__
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
 
 #include "Common.h"
 #include "Memory.h"
+#include "vtlb.h"
 #include "System/SysThreads.h"
+#include "Counters.h"
 #include "svnrev.h"
 #include "IPC.h"
 
 SocketIPC::SocketIPC(SysCoreThread* vm)
 	: pxThread("IPC_Socket")
 {
+	// we save a handle of the main vm object
+	m_vm = vm;
+
+	m_frame_buffer = new char[MAX_IPC_FRAME_SIZE];
+	memset(m_frame_buffer, 0, m_frame_size);
+
+#ifdef __linux__
+	// the shared memory transport is optional, clients can always fall back
+	// to the socket.
+	// a client may still have a segment from a previous instance mapped, so
+	// we unlink it and create a fresh one rather than re-initializing the
+	// semaphores under its feet.
+	shm_unlink(IPC_SHM_NAME);
+	int shm_fd = shm_open(IPC_SHM_NAME, O_CREAT | O_EXCL | O_RDWR, 0600);
+	if (shm_fd >= 0 && ftruncate(shm_fd, sizeof(IPCSharedMemory)) == 0)
+	{
+		void* shm = mmap(NULL, sizeof(IPCSharedMemory), PROT_READ | PROT_WRITE, MAP_SHARED, shm_fd, 0);
+		if (shm != MAP_FAILED)
+		{
+			m_shm = (IPCSharedMemory*)shm;
+			m_shm->magic = IPC_SHM_MAGIC;
+			m_shm->version = 1;
+			m_shm->frame_seq.store(0);
+			memset(m_shm->frame, 0, m_frame_size);
+			sem_init(&m_shm->request_ready, 1, 0);
+			sem_init(&m_shm->reply_ready, 1, 0);
+
+			m_shm_end = false;
+			m_shm_thread = std::thread(&SocketIPC::SharedMemoryTask, this);
+		}
+	}
+	if (shm_fd >= 0)
+		close(shm_fd);
+	if (!m_shm)
+		Console.WriteLn(Color_Red, "IPC: Cannot create shared memory segment, only the socket will be available.");
+#endif
+
 #ifdef _WIN32
 	WSADATA wsa;
 	struct sockaddr_in server;
@@ -112,9 +155,6 @@ SocketIPC::SocketIPC(SysCoreThread* vm)
 	// that a "reasonable" value is 5, which is not.
 	listen(m_sock, 4096);
 
-	// we save a handle of the main vm object
-	m_vm = vm;
-
 	// we start the thread
 	Start();
 }
@@ -231,9 +271,85 @@ void SocketIPC::ExecuteTaskInThread()
 	return;
 }
 
+#ifdef __linux__
+void SocketIPC::SharedMemoryTask()
+{
+	while (true)
+	{
+		if (sem_wait(&m_shm->request_ready) != 0)
+			continue;
+		if (m_shm_end)
+			break;
+
+		// same framing as the socket: the first 4 bytes are the message size.
+		const u32 size = FromArray<u32>(m_shm->request, 0);
+		if (size > MAX_IPC_SIZE || size < 4)
+			MakeFailIPC(m_shm->reply);
+		else
+			ParseCommand(&m_shm->request[4], m_shm->reply, size - 4);
+
+		sem_post(&m_shm->reply_ready);
+	}
+}
+#endif
+
+void SocketIPC::VsyncInThread()
+{
+	ScopedLock lock(m_subscription_lock);
+
+	u32 count = 0;
+	u32 frame_cnt = 8;
+	for (u32 i = 0; i < MAX_IPC_SUBSCRIPTIONS; i++)
+	{
+		const IPCSubscription& sub = m_subscriptions[i];
+		if (!sub.size)
+			continue;
+		ToArray(m_frame_buffer, i, frame_cnt);
+		ToArray(m_frame_buffer, sub.addr, frame_cnt + 4);
+		ToArray(m_frame_buffer, sub.size, frame_cnt + 8);
+		// the guest may have remapped the block since it was subscribed to,
+		// unmapped pages would raise a tlb miss on the core thread.
+		if (vtlb_IsMapped(sub.addr, sub.size))
+			vtlb_memReadBlock(sub.addr, &m_frame_buffer[frame_cnt + 12], sub.size);
+		else
+			memset(&m_frame_buffer[frame_cnt + 12], 0, sub.size);
+		frame_cnt += 12 + sub.size;
+		count++;
+	}
+
+	// nothing watched, nothing to publish.
+	if (!count && m_frame_size == 8)
+		return;
+
+	ToArray(m_frame_buffer, ++m_frame_count, 0);
+	ToArray(m_frame_buffer, count, 4);
+	m_frame_size = frame_cnt;
+
+#ifdef __linux__
+	if (m_shm)
+	{
+		m_shm->frame_seq.fetch_add(1, std::memory_order_acq_rel);
+		memcpy(m_shm->frame, m_frame_buffer, m_frame_size);
+		m_shm->frame_seq.fetch_add(1, std::memory_order_release);
+	}
+#endif
+}
+
 SocketIPC::~SocketIPC()
 {
 	m_end = true;
+#ifdef __linux__
+	if (m_shm)
+	{
+		m_shm_end = true;
+		sem_post(&m_shm->request_ready);
+		m_shm_thread.join();
+		sem_destroy(&m_shm->request_ready);
+		sem_destroy(&m_shm->reply_ready);
+		munmap(m_shm, sizeof(IPCSharedMemory));
+		shm_unlink(IPC_SHM_NAME);
+	}
+#endif
 #ifdef _WIN32
 	WSACleanup();
 #else
@@ -243,6 +359,7 @@ SocketIPC::~SocketIPC()
 	close_portable(m_msgsock);
 	delete[] m_ret_buffer;
 	delete[] m_ipc_buffer;
+	delete[] m_frame_buffer;
 	// destroy the thread
 	try
 	{
@@ -382,6 +499,152 @@ SocketIPC::IPCBuffer SocketIPC::ParseCommand(char* buf, char* ret_buffer, u32 bu
 				ret_cnt += 256;
 				break;
 			}
+			// bulk commands, the size of the block follows the address:
+			// format: XX YY YY YY YY SS SS SS SS [data]
+			// reply:  XX [data]
+			case MsgReadBlock:
+			{
+				if (!m_vm->HasActiveMachine())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+					goto error;
+				const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+				const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+				if (!SafetyChecksBlock(buf_cnt + 8, 0, ret_cnt, size, buf_size) || !vtlb_IsMapped(a, size))
+					goto error;
+				vtlb_memReadBlock(a, &ret_buffer[ret_cnt], size);
+				ret_cnt += size;
+				buf_cnt += 8;
+				break;
+			}
+			case MsgWriteBlock:
+			{
+				if (!m_vm->HasActiveMachine())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+					goto error;
+				const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+				const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+				if (!SafetyChecksBlock(buf_cnt + 8, size, ret_cnt, 0, buf_size) || !vtlb_IsMapped(a, size))
+					goto error;
+				vtlb_memWriteBlock(a, &buf[buf_cnt + 8], size);
+				buf_cnt += 8 + size;
+				break;
+			}
+			// scatter-gather lists, a count followed by address/size pairs:
+			// format: XX CC CC CC CC [YY YY YY YY SS SS SS SS [data]]...
+			// reply:  XX [data]...
+			case MsgReadScatter:
+			{
+				if (!m_vm->HasActiveMachine())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size))
+					goto error;
+				const u32 count = FromArray<u32>(&buf[buf_cnt], 0);
+				buf_cnt += 4;
+				if (count >= MAX_IPC_SIZE / 8 || !SafetyChecksBlock(buf_cnt, count * 8, ret_cnt, 0, buf_size))
+					goto error;
+				for (u32 i = 0; i < count; i++)
+				{
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecksBlock(buf_cnt + 8, 0, ret_cnt, size, buf_size) || !vtlb_IsMapped(a, size))
+						goto error;
+					vtlb_memReadBlock(a, &ret_buffer[ret_cnt], size);
+					ret_cnt += size;
+					buf_cnt += 8;
+				}
+				break;
+			}
+			case MsgWriteScatter:
+			{
+				if (!m_vm->HasActiveMachine())
+					goto error;
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size))
+					goto error;
+				const u32 count = FromArray<u32>(&buf[buf_cnt], 0);
+				buf_cnt += 4;
+				for (u32 i = 0; i < count; i++)
+				{
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+						goto error;
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecksBlock(buf_cnt + 8, size, ret_cnt, 0, buf_size) || !vtlb_IsMapped(a, size))
+						goto error;
+					vtlb_memWriteBlock(a, &buf[buf_cnt + 8], size);
+					buf_cnt += 8 + size;
+				}
+				break;
+			}
+			// per-frame subscriptions, the watched blocks are copied at
+			// every vsync and can be read back with MsgReadFrame, or from
+			// the shared memory segment.
+			// format: XX YY YY YY YY SS SS SS SS
+			// reply:  XX II II II II (subscription id)
+			case MsgSubscribe:
+			{
+				if (!SafetyChecks(buf_cnt, 8, ret_cnt, 4, buf_size))
+					goto error;
+				const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+				const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+
+				ScopedLock lock(m_subscription_lock);
+				u32 total = 0;
+				u32 id = MAX_IPC_SUBSCRIPTIONS;
+				for (u32 i = 0; i < MAX_IPC_SUBSCRIPTIONS; i++)
+				{
+					total += m_subscriptions[i].size;
+					if (!m_subscriptions[i].size && id == MAX_IPC_SUBSCRIPTIONS)
+						id = i;
+				}
+				if (!size || id == MAX_IPC_SUBSCRIPTIONS || size > MAX_IPC_SUBSCRIPTION_SIZE - total || !vtlb_IsMapped(a, size))
+					goto error;
+				m_subscriptions[id] = IPCSubscription{a, size};
+
+				ToArray(ret_buffer, id, ret_cnt);
+				ret_cnt += 4;
+				buf_cnt += 8;
+				break;
+			}
+			case MsgUnsubscribe:
+			{
+				if (!SafetyChecks(buf_cnt, 4, ret_cnt, 0, buf_size))
+					goto error;
+				const u32 id = FromArray<u32>(&buf[buf_cnt], 0);
+				if (id >= MAX_IPC_SUBSCRIPTIONS)
+					goto error;
+
+				ScopedLock lock(m_subscription_lock);
+				m_subscriptions[id].size = 0;
+				buf_cnt += 4;
+				break;
+			}
+			case MsgReadFrame:
+			{
+				ScopedLock lock(m_subscription_lock);
+				if (!SafetyChecks(buf_cnt, 0, ret_cnt, m_frame_size, buf_size))
+					goto error;
+				memcpy(&ret_buffer[ret_cnt], m_frame_buffer, m_frame_size);
+				ret_cnt += m_frame_size;
+				break;
+			}
+			// time between fields leaving the frame limiter, in microseconds,
+			// over the last window of fields.
+			// reply: XX NN NN NN NN (fields) MM MM MM MM (p50)
+			//        PP PP PP PP (p99) AA AA AA AA (max)
+			case MsgFrameTimes:
+			{
+				if (!SafetyChecks(buf_cnt, 0, ret_cnt, 16, buf_size))
+					goto error;
+				const FrameTimeStats stats = frameTimeGetStats();
+				ToArray(ret_buffer, stats.Frames, ret_cnt);
+				ToArray(ret_buffer, stats.P50, ret_cnt + 4);
+				ToArray(ret_buffer, stats.P99, ret_cnt + 8);
+				ToArray(ret_buffer, stats.Max, ret_cnt + 12);
+				ret_cnt += 16;
+				break;
+			}
 			default:
 			{
 			error:
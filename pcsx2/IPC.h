@@ -20,6 +20,8 @@
 
 #if _WIN32
 #include <windows.h>
+#elif defined(__linux__)
+#include <semaphore.h>
 #endif
 
 #include "Utilities/PersistentThread.h"
@@ -75,6 +77,81 @@ protected:
 	 */
 	char* m_ipc_buffer;
 
+	/**
+	 * Maximum number of regions watched through MsgSubscribe.
+	 */
+#define MAX_IPC_SUBSCRIPTIONS 64
+
+	/**
+	 * Maximum total memory watched through MsgSubscribe.
+	 * Must leave room for the frame header in a reply.
+	 */
+#define MAX_IPC_SUBSCRIPTION_SIZE 0x40000
+
+	/**
+	 * Maximum size of a published frame, see m_frame_buffer.
+	 */
+#define MAX_IPC_FRAME_SIZE (MAX_IPC_SUBSCRIPTION_SIZE + 8 + MAX_IPC_SUBSCRIPTIONS * 12)
+
+	/**
+	 * Memory region watched by a client.
+	 * Watched regions are copied at every vsync, so that clients get
+	 * a consistent view of them as of the end of the last frame.
+	 */
+	struct IPCSubscription
+	{
+		u32 addr;    /**< Start address of the region. */
+		u32 size;    /**< Size of the region, 0 if the slot is unused. */
+	};
+
+	IPCSubscription m_subscriptions[MAX_IPC_SUBSCRIPTIONS] = {};
+
+	/**
+	 * Frame published at the last vsync.
+	 * format: frame count (4 bytes), region count (4 bytes), followed by
+	 * for each region: id (4 bytes), address (4 bytes), size (4 bytes), data.
+	 */
+	char* m_frame_buffer;
+	u32 m_frame_size = 8;
+	u32 m_frame_count = 0;
+
+	// protects m_subscriptions and m_frame_buffer, which are accessed by both
+	// the IPC threads and the core thread at vsync.
+	Mutex m_subscription_lock;
+
+#ifdef __linux__
+	/**
+	 * Shared memory transport.
+	 * Local clients can map this segment instead of going through the socket:
+	 * a request is written to request (same format as a socket message) and
+	 * signaled through request_ready, the reply is written to reply and
+	 * signaled through reply_ready.  Subscribed regions are pushed into frame
+	 * at every vsync, guarded by the frame_seq sequence lock (odd while the
+	 * frame is being written).
+	 */
+#define IPC_SHM_NAME "/pcsx2.ipc"
+#define IPC_SHM_MAGIC 0x32585350 // "PSX2"
+
+	struct IPCSharedMemory
+	{
+		u32 magic;
+		u32 version;
+		sem_t request_ready;
+		sem_t reply_ready;
+		std::atomic<u32> frame_seq;
+		char request[MAX_IPC_SIZE];
+		char reply[MAX_IPC_RETURN_SIZE];
+		char frame[MAX_IPC_FRAME_SIZE];
+	};
+
+	IPCSharedMemory* m_shm = nullptr;
+	std::thread m_shm_thread;
+	std::atomic<bool> m_shm_end{true};
+
+	// Thread used to relay IPC commands from the shared memory transport.
+	void SharedMemoryTask();
+#endif
+
 	/**
 	 * IPC Command messages opcodes.  
 	 * A list of possible operations possible by the IPC.  
@@ -92,6 +169,14 @@ protected:
 		MsgWrite32 = 6,         /**< Write 32 bit value to memory. */
 		MsgWrite64 = 7,         /**< Write 64 bit value to memory. */
 		MsgVersion = 8,         /**< Returns PCSX2 version. */
+		MsgReadBlock = 9,       /**< Read a block of memory. */
+		MsgWriteBlock = 10,     /**< Write a block of memory. */
+		MsgReadScatter = 11,    /**< Read a list of memory blocks. */
+		MsgWriteScatter = 12,   /**< Write a list of memory blocks. */
+		MsgSubscribe = 13,      /**< Watch a memory block at every vsync. */
+		MsgUnsubscribe = 14,    /**< Stop watching a memory block. */
+		MsgReadFrame = 15,      /**< Read the watched blocks of the last vsync. */
+		MsgFrameTimes = 16,     /**< Frame pacing statistics of the last window of fields. */
 		MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 	};
 
@@ -184,10 +269,27 @@ protected:
 		return true;
 	}
 
+	/**
+	 * Ensures a variable-length block fits in an IPC message.
+	 * return value: false if checks failed, true otherwise.
+	 */
+	static inline bool SafetyChecksBlock(u32 command_len, u32 command_size, u32 reply_len, u32 reply_size, u32 buf_size)
+	{
+		if (command_size >= MAX_IPC_SIZE || reply_size >= MAX_IPC_RETURN_SIZE)
+			return false;
+		return SafetyChecks(command_len, command_size, reply_len, reply_size, buf_size);
+	}
+
 public:
 	// Whether the socket processing thread should stop executing/is stopped.
 	bool m_end = true;
 
+	/**
+	 * Copies the watched regions into the published frame.
+	 * Called by the core thread at every vsync.
+	 */
+	void VsyncInThread();
+
 	/* Initializers */
 	SocketIPC(SysCoreThread* vm);
 	virtual ~SocketIPC();
@@ -81,7 +81,7 @@ void intMemcheck(u32 op, u32 bits, bool store)
 	{
 		auto& check = checks[i];
 
-		if (check.result == 0)
+		if (check.result == 0 || check.UsesPageProtection())
 			continue;
 		if ((check.cond & MEMCHECK_WRITE) == 0 && store)
 			continue;
@@ -124,6 +124,96 @@ void intCheckMemcheck()
 	}
 }
 
+// --------------------------------------------------------------------------------------
+//  Decoded instruction cache
+// --------------------------------------------------------------------------------------
+// Fetching every instruction through memRead32 and walking the opcode tables for its handler
+// is most of the interpreter's overhead.  Code in main ram and the bios is decoded a page at
+// a time into direct handler records instead, and the page is only looked up again when the
+// pc leaves it.
+//
+// Ram pages are write protected the same way the recompiler protects them, so a store into
+// decoded code lands in intClear through the page fault handler.  Pages under manual
+// protection, the EE cache emulation and all other memory regions keep the plain fetch.
+
+struct intDecodedOp
+{
+	u32		code;
+	u32		cycles;
+	void	(*interpret)();
+};
+
+static const uint intDecodedPageOps = 0x1000 / 4;
+
+struct intDecodedPage
+{
+	bool			valid;
+	intDecodedOp	op[intDecodedPageOps];
+};
+
+static std::unique_ptr<intDecodedPage> s_ramDecoded[Ps2MemSize::MainRam >> 12];
+static std::unique_ptr<intDecodedPage> s_romDecoded[Ps2MemSize::Rom >> 12];
+
+// virtual page of the last lookup, and its decoded page (NULL when it uses the plain fetch)
+static u32 s_curVPage = ~0u;
+static intDecodedPage* s_curPage = NULL;
+
+static intDecodedPage* intGetDecodedPage( std::unique_ptr<intDecodedPage>& page, const u8* code )
+{
+	if( !page ) page = std::make_unique<intDecodedPage>();
+	if( page->valid ) return page.get();
+
+	const u32* words = (const u32*)code;
+	for( uint i = 0; i < intDecodedPageOps; ++i )
+	{
+		const OPCODE& opcode = GetInstruction( words[i] );
+		page->op[i].code = words[i];
+		page->op[i].cycles = opcode.cycles;
+		page->op[i].interpret = opcode.interpret;
+	}
+	page->valid = true;
+
+	return page.get();
+}
+
+static intDecodedPage* intLookupPage( u32 pc )
+{
+	if( CHECK_CACHE ) return NULL;
+
+	pc &= ~0xfff;
+
+	const vtlb_private::VTLBVirtual& vmv = vtlb_private::vtlbdata.vmap[pc >> vtlb_private::VTLB_PAGE_BITS];
+	if( vmv.isHandler(pc) ) return NULL;
+
+	const u8* ptr = (const u8*)vmv.assumePtr(pc);
+
+	uptr offset = (uptr)ptr - (uptr)eeMem->Main;
+	if( offset < Ps2MemSize::MainRam )
+	{
+		if( mmap_GetRamPageInfo( offset ) == ProtMode_Manual ) return NULL;
+
+		mmap_MarkCountedRamPage( offset );
+		return intGetDecodedPage( s_ramDecoded[offset >> 12], ptr );
+	}
+
+	offset = (uptr)ptr - (uptr)eeMem->ROM;
+	if( offset < Ps2MemSize::Rom )
+		return intGetDecodedPage( s_romDecoded[offset >> 12], ptr );
+
+	return NULL;
+}
+
+static void intInvalidateDecoded()
+{
+	for( uint i = 0; i < ArraySize(s_ramDecoded); ++i )
+		if( s_ramDecoded[i] ) s_ramDecoded[i]->valid = false;
+	for( uint i = 0; i < ArraySize(s_romDecoded); ++i )
+		if( s_romDecoded[i] ) s_romDecoded[i]->valid = false;
+
+	s_curVPage = ~0u;
+	s_curPage = NULL;
+}
+
 static void execI()
 {
 	// execI is called for every instruction so it must remains as light as possible.
@@ -145,6 +235,22 @@ static void execI()
 	// and it expects the PC counter to be pre-incremented
 	cpuRegs.pc += 4;
 
+	if( (pc >> 12) != s_curVPage )
+	{
+		s_curVPage = pc >> 12;
+		s_curPage = intLookupPage( pc );
+	}
+
+	if( s_curPage )
+	{
+		// Note: the handler may invalidate the page, don't touch the record after it.
+		const intDecodedOp& op = s_curPage->op[(pc >> 2) & (intDecodedPageOps - 1)];
+		cpuRegs.code = op.code;
+		cpuBlockCycles += op.cycles;
+		op.interpret();
+		return;
+	}
+
 	// interprete instruction
 	cpuRegs.code = memRead32( pc );
 	// Honestly I think this code is useless nowadays.
@@ -496,10 +602,21 @@ static void intReset()
 {
 	cpuRegs.branch = 0;
 	branch2 = 0;
+
+	// the decoded pages rely on the same write protection as the recompiler
+	mmap_ResetBlockTracking();
+	intInvalidateDecoded();
 }
 
 static void intEventTest()
 {
+	if (mmap_TestMemchecks())
+	{
+		CBreakPoints::SetBreakpointTriggered(true);
+		GetCoreThread().PauseSelfDebug();
+		throw Exception::ExitCpuExecute();
+	}
+
 	// Perform counters, ints, and IOP updates:
 	_cpuEventTest_Shared();
 }
@@ -591,6 +708,16 @@ static void intStep()
 
 static void intClear(u32 Addr, u32 Size)
 {
+	// Called with whole pages by the page fault handler and the TLB code.
+	for( u32 addr = Addr & ~0xfff; addr < Addr + Size * 4; addr += 0x1000 )
+	{
+		uptr offset = (uptr)PSM( addr ) - (uptr)eeMem->Main;
+		if( offset < Ps2MemSize::MainRam && s_ramDecoded[offset >> 12] )
+			s_ramDecoded[offset >> 12]->valid = false;
+	}
+
+	s_curVPage = ~0u;
+	s_curPage = NULL;
 }
 
 static void intShutdown() {
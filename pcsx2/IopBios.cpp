@@ -20,6 +20,7 @@
 
 #include <ctype.h>
 #include <string.h>
+#include <algorithm>
 
 #ifndef O_BINARY
 #define O_BINARY 0
@@ -728,4 +729,36 @@ int irxImportExec(u32 import_table, u16 index)
 		return 0;
 }
 
+// Finds the export tables of the loaded libraries in iop ram (they are left in place by
+// loadcore's RegisterLibraryEntries), and returns their functions sorted by address.
+std::vector<irxExport> irxScanExports()
+{
+	std::vector<irxExport> exports;
+	if (!iopMem)
+		return exports;
+
+	const u32* ram = (const u32*)iopMem->Main;
+	const u32 words = Ps2MemSize::IopRam / 4;
+
+	for (u32 i = 0; i + 5 < words; i++) {
+		if (ram[i] != 0x41c00000)
+			continue;
+
+		const std::string libname = iopMemReadString(i * 4 + 12, 8);
+		if (libname.empty() || !std::all_of(libname.begin(), libname.end(), [](char c) { return isprint((u8)c); }))
+			continue;
+
+		for (u32 j = i + 5, index = 0; j < words && ram[j]; j++, index++) {
+			const u32 addr = ram[j] & 0x1fffffff;
+			if (addr >= Ps2MemSize::IopRam)
+				break;
+			exports.push_back({addr, (u16)index, libname});
+		}
+	}
+
+	std::sort(exports.begin(), exports.end(), [](const irxExport& a, const irxExport& b) { return a.addr < b.addr; });
+
+	return exports;
+}
+
 }	// end namespace R3000A
@@ -61,6 +61,14 @@ public:
 typedef int (*irxHLE)(); // return 1 if handled, otherwise 0
 typedef void (*irxDEBUG)();
 
+// A function exported by a library registered with loadcore.
+struct irxExport
+{
+	u32 addr;				// physical address of the function
+	u16 index;				// export index within the library
+	std::string libname;
+};
+
 namespace R3000A
 {
 	u32 irxImportTableAddr(u32 entrypc);
@@ -70,6 +78,7 @@ namespace R3000A
 	void irxImportLog(const std::string &libnameptr, u16 index, const char *funcname);
 	void __fastcall irxImportLog_rec(u32 import_table, u16 index, const char *funcname);
 	int irxImportExec(u32 import_table, u16 index);
+	std::vector<irxExport> irxScanExports();
 
 	namespace ioman
 	{
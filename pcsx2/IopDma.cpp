@@ -197,6 +197,9 @@ void psxDma9(u32 madr, u32 bcr, u32 chcr)
 {
 	SIF_LOG("IOP: dmaSIF0 chcr = %lx, madr = %lx, bcr = %lx, tadr = %lx", chcr, madr, bcr, HW_DMA9_TADR);
 
+	// The transfer runs both ends of the SIF, see the Threaded IOP notes in R3000A.cpp
+	iopThreadSyncEE();
+
 	sif0.iop.busy = true;
 	sif0.iop.end = false;
 
@@ -207,6 +210,8 @@ void psxDma10(u32 madr, u32 bcr, u32 chcr)
 {
 	SIF_LOG("IOP: dmaSIF1 chcr = %lx, madr = %lx, bcr = %lx", chcr, madr, bcr);
 
+	iopThreadSyncEE();
+
 	sif1.iop.busy = true;
 	sif1.iop.end = false;
 
@@ -183,6 +183,9 @@ u16 __fastcall iopMemRead16(u32 mem)
 		{
 			if (t == 0x1d00)
 			{
+				// SBUS registers live on the EE side, see the Threaded IOP notes in R3000A.cpp
+				iopThreadSyncEE();
+
 				u16 ret;
 				switch(mem & 0xF0)
 				{
@@ -243,6 +246,8 @@ u32 __fastcall iopMemRead32(u32 mem)
 		{
 			if (t == 0x1d00)
 			{
+				iopThreadSyncEE();
+
 				u32 ret;
 				switch(mem & 0x8F0)
 				{
@@ -360,6 +365,8 @@ void __fastcall iopMemWrite16(u32 mem, u16 value)
 		{
 			if (t == 0x1d00)
 			{
+				iopThreadSyncEE();
+
 				switch (mem & 0x8f0)
 				{
 					case 0x10:
@@ -433,6 +440,8 @@ void __fastcall iopMemWrite32(u32 mem, u32 value)
 		{
 			if (t == 0x1d00)
 			{
+				iopThreadSyncEE();
+
 				MEM_LOG("iop Sif reg write %x value %x", mem, value);
 				switch (mem & 0x8f0)
 				{
@@ -81,6 +81,9 @@ void SysMtgsThread::OnStart()
 
 	m_CopyDataTally		= 0;
 
+	// pins queued in a ring that was dropped
+	mmap_ReleasePendingPins();
+
 	_parent::OnStart();
 }
 
@@ -109,6 +112,7 @@ void SysMtgsThread::ResetGS()
 	m_ReadPos             = m_WritePos.load();
 	m_QueuedFrameCount    = 0;
 	m_VsyncSignalListener = 0;
+	mmap_ReleasePendingPins();
 
 	MTGS_LOG( "MTGS: Sending Reset..." );
 	SendSimplePacket( GS_RINGTYPE_RESET, 0, 0, 0 );
@@ -437,6 +441,14 @@ void SysMtgsThread::ExecuteTaskInThread()
 					break;
 				}
 
+				case GS_RINGTYPE_GSPACKET_PINNED: {
+					u32       size = 0;
+					const u8* data = mmap_AcquirePin(tag.data[0], size);
+					GSgifTransfer((u32*)data, size/16);
+					mmap_ReleasePin(tag.data[0]);
+					break;
+				}
+
 				case GS_RINGTYPE_MTVU_GSPACKET: {
 					MTVU_LOG("MTGS - Waiting on semaXGkick!");
 					vu1Thread.KickStart(true);
@@ -557,6 +569,7 @@ void SysMtgsThread::ExecuteTaskInThread()
 							Console.Error("GSThreadProc, bad packet (%x) at m_ReadPos: %x, m_WritePos: %x", tag.command, local_ReadPos, m_WritePos.load());
 							pxFail( "Bad packet encountered in the MTGS Ringbuffer." );
 							m_ReadPos.store(m_WritePos.load(std::memory_order_acquire), std::memory_order_release);
+							mmap_ReleasePendingPins();
 						continue;
 #else
 						// Optimized performance in non-Dev builds.
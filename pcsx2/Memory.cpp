@@ -36,6 +36,7 @@ BIOS
 
 #include "PrecompiledHeader.h"
 #include <wx/file.h>
+#include <atomic>
 
 #include "IopCommon.h"
 #include "GS.h"
@@ -47,6 +48,8 @@ BIOS
 #include "SPU2/spu2.h"
 
 #include "Utilities/PageFaultSource.h"
+#include "DebugTools/Breakpoints.h"
+#include "System/SysThreads.h"
 
 #ifdef ENABLECACHE
 #include "Cache.h"
@@ -106,6 +109,8 @@ static vtlbHandler
 	vu1_micro_mem,
 	vu1_data_mem,
 
+	iop_main_mem,
+
 	hw_by_page[0x10] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
 
 	gs_page_0,
@@ -156,8 +161,9 @@ void memMapPhy()
 
 	// IOP memory
 	// (used by the EE Bios Kernel during initial hardware initialization, Apps/Games
-	//  are "supposed" to use the thread-safe SIF instead.)
-	vtlb_MapBlock(iopMem->Main,0x1c000000,0x00800000);
+	//  are "supposed" to use the thread-safe SIF instead.)  Mapped through a handler
+	//  rather than directly so that accesses can sync with the IOP thread.
+	vtlb_MapHandler(iop_main_mem,0x1c000000,0x00800000);
 
 	// Generic Handlers; These fallback to mem* stuff...
 	vtlb_MapHandler(tlb_fallback_7,0x14000000, _64kb);
@@ -637,6 +643,109 @@ template<int vunum> static void __fc vuDataWrite128(u32 addr, const mem128_t* da
 	CopyQWC(&vu->Mem[addr], data);
 }
 
+// IOP Memory / IOP Hw Registers (EE side)
+// Only the EE Bios kernel touches these (during IOP init), but with THREAD_IOP an IOP timeslice
+// may still be running on the IOP thread, so every access joins it first (iopThreadJoin is a
+// no-op when no slice is in flight).  IOP ram is 2MB, mirrored across the 8MB window.
+static mem8_t __fc iopRamRead8(u32 addr) {
+	iopThreadJoin();
+	return iopMem->Main[addr & (Ps2MemSize::IopRam-1)];
+}
+static mem16_t __fc iopRamRead16(u32 addr) {
+	iopThreadJoin();
+	return *(u16*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)];
+}
+static mem32_t __fc iopRamRead32(u32 addr) {
+	iopThreadJoin();
+	return *(u32*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)];
+}
+static void __fc iopRamRead64(u32 addr, mem64_t* data) {
+	iopThreadJoin();
+	*data = *(u64*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)];
+}
+static void __fc iopRamRead128(u32 addr, mem128_t* data) {
+	iopThreadJoin();
+	CopyQWC(data, &iopMem->Main[addr & (Ps2MemSize::IopRam-1)]);
+}
+static void __fc iopRamWrite8(u32 addr, mem8_t data) {
+	iopThreadJoin();
+	iopMem->Main[addr & (Ps2MemSize::IopRam-1)] = data;
+}
+static void __fc iopRamWrite16(u32 addr, mem16_t data) {
+	iopThreadJoin();
+	*(u16*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)] = data;
+}
+static void __fc iopRamWrite32(u32 addr, mem32_t data) {
+	iopThreadJoin();
+	*(u32*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)] = data;
+}
+static void __fc iopRamWrite64(u32 addr, const mem64_t* data) {
+	iopThreadJoin();
+	*(u64*)&iopMem->Main[addr & (Ps2MemSize::IopRam-1)] = data[0];
+}
+static void __fc iopRamWrite128(u32 addr, const mem128_t* data) {
+	iopThreadJoin();
+	CopyQWC(&iopMem->Main[addr & (Ps2MemSize::IopRam-1)], data);
+}
+
+template<int page> static mem8_t __fc iopHwPageRead8(u32 addr) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: return IopMemory::iopHwRead8_Page1(addr);
+		case 3: return IopMemory::iopHwRead8_Page3(addr);
+		case 8: return IopMemory::iopHwRead8_Page8(addr);
+	}
+	return 0;
+}
+template<int page> static mem16_t __fc iopHwPageRead16(u32 addr) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: return IopMemory::iopHwRead16_Page1(addr);
+		case 3: return IopMemory::iopHwRead16_Page3(addr);
+		case 8: return IopMemory::iopHwRead16_Page8(addr);
+	}
+	return 0;
+}
+template<int page> static mem32_t __fc iopHwPageRead32(u32 addr) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: return IopMemory::iopHwRead32_Page1(addr);
+		case 3: return IopMemory::iopHwRead32_Page3(addr);
+		case 8: return IopMemory::iopHwRead32_Page8(addr);
+	}
+	return 0;
+}
+template<int page> static void __fc iopHwPageWrite8(u32 addr, mem8_t data) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: IopMemory::iopHwWrite8_Page1(addr, data); break;
+		case 3: IopMemory::iopHwWrite8_Page3(addr, data); break;
+		case 8: IopMemory::iopHwWrite8_Page8(addr, data); break;
+	}
+}
+template<int page> static void __fc iopHwPageWrite16(u32 addr, mem16_t data) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: IopMemory::iopHwWrite16_Page1(addr, data); break;
+		case 3: IopMemory::iopHwWrite16_Page3(addr, data); break;
+		case 8: IopMemory::iopHwWrite16_Page8(addr, data); break;
+	}
+}
+template<int page> static void __fc iopHwPageWrite32(u32 addr, mem32_t data) {
+	iopThreadJoin();
+	switch (page)
+	{
+		case 1: IopMemory::iopHwWrite32_Page1(addr, data); break;
+		case 3: IopMemory::iopHwWrite32_Page3(addr, data); break;
+		case 8: IopMemory::iopHwWrite32_Page8(addr, data); break;
+	}
+}
+
 
 void memSetPageAddr(u32 vaddr, u32 paddr)
 {
@@ -669,6 +778,11 @@ public:
 
 static mmap_PageFaultHandler* mmap_faultHandler = NULL;
 
+static void mmap_DisarmMemchecks();
+static void mmap_DetachPins();
+static void mmap_DetachPinsOnMemchecks();
+static bool mmap_HandlePinFault( uint rampage );
+
 EEVM_MemoryAllocMess* eeMem = NULL;
 __pagealigned u8 eeHw[Ps2MemSize::Hardware];
 
@@ -729,7 +843,10 @@ void eeMemoryReserve::Reset()
 		pxAssert(Source_PageFault);
 		mmap_faultHandler = new mmap_PageFaultHandler();
 	}
-	
+
+	// Clearing the ram must not trip the memchecks, they are re-armed by the next event test.
+	mmap_DisarmMemchecks();
+	mmap_DetachPins();
 	_parent::Reset();
 
 	// Note!!  Ideally the vtlb should only be initialized once, and then subsequent
@@ -759,6 +876,9 @@ void eeMemoryReserve::Reset()
 	vu0_micro_mem = vtlb_RegisterHandlerTempl1(vuMicro,0);
 	vu1_micro_mem = vtlb_RegisterHandlerTempl1(vuMicro,1);
 	vu1_data_mem  = (1||THREAD_VU1) ? vtlb_RegisterHandlerTempl1(vuData,1) : 0;
+
+	iop_main_mem = vtlb_RegisterHandler(iopRamRead8, iopRamRead16, iopRamRead32, iopRamRead64, iopRamRead128,
+		iopRamWrite8, iopRamWrite16, iopRamWrite32, iopRamWrite64, iopRamWrite128);
 	
 	//////////////////////////////////////////////////////////////////////////////////////////
 	// IOP's "secret" Hardware Register mapping, accessible from the EE (and meant for use
@@ -774,18 +894,18 @@ void eeMemoryReserve::Reset()
 	);
 
 	iopHw_by_page_01 = vtlb_RegisterHandler(
-		iopHwRead8_Page1, iopHwRead16_Page1, iopHwRead32_Page1, _ext_memRead64<2>, _ext_memRead128<2>,
-		iopHwWrite8_Page1, iopHwWrite16_Page1, iopHwWrite32_Page1, _ext_memWrite64<2>, _ext_memWrite128<2>
+		iopHwPageRead8<1>, iopHwPageRead16<1>, iopHwPageRead32<1>, _ext_memRead64<2>, _ext_memRead128<2>,
+		iopHwPageWrite8<1>, iopHwPageWrite16<1>, iopHwPageWrite32<1>, _ext_memWrite64<2>, _ext_memWrite128<2>
 	);
 
 	iopHw_by_page_03 = vtlb_RegisterHandler(
-		iopHwRead8_Page3, iopHwRead16_Page3, iopHwRead32_Page3, _ext_memRead64<2>, _ext_memRead128<2>,
-		iopHwWrite8_Page3, iopHwWrite16_Page3, iopHwWrite32_Page3, _ext_memWrite64<2>, _ext_memWrite128<2>
+		iopHwPageRead8<3>, iopHwPageRead16<3>, iopHwPageRead32<3>, _ext_memRead64<2>, _ext_memRead128<2>,
+		iopHwPageWrite8<3>, iopHwPageWrite16<3>, iopHwPageWrite32<3>, _ext_memWrite64<2>, _ext_memWrite128<2>
 	);
 
 	iopHw_by_page_08 = vtlb_RegisterHandler(
-		iopHwRead8_Page8, iopHwRead16_Page8, iopHwRead32_Page8, _ext_memRead64<2>, _ext_memRead128<2>,
-		iopHwWrite8_Page8, iopHwWrite16_Page8, iopHwWrite32_Page8, _ext_memWrite64<2>, _ext_memWrite128<2>
+		iopHwPageRead8<8>, iopHwPageRead16<8>, iopHwPageRead32<8>, _ext_memRead64<2>, _ext_memRead128<2>,
+		iopHwPageWrite8<8>, iopHwPageWrite16<8>, iopHwPageWrite32<8>, _ext_memWrite64<2>, _ext_memWrite128<2>
 	);
 
 
@@ -904,6 +1024,101 @@ struct vtlb_PageProtectionInfo
 
 static __aligned16 vtlb_PageProtectionInfo m_PageProtectInfo[Ps2MemSize::MainRam >> 12];
 
+// --------------------------------------------------------------------------------------
+//  Memory breakpoints (memchecks) on main ram
+// --------------------------------------------------------------------------------------
+// Pages holding a memcheck are protected on top of the block tracking protection above:
+// no access for read checks, read-only for write checks.  The fault handler records the
+// hit, drops the page back to its block tracking protection so the access can complete,
+// and requests an event test; mmap_TestMemchecks then reports the hits and re-arms the
+// page.  Recompiled code is not involved at all, so it doesn't need to be flushed when
+// memchecks are added or removed.
+//
+// Hits are filtered at 16 byte granularity (the fault only gives the start of the access),
+// and accesses to the page between a fault and the next event test are not seen.  For the
+// same reason MEMCHECK_WRITE_ONCHANGE compares the whole 16 byte line: the fault saves it,
+// and the event test drops the hit if the line still holds the same data.
+//
+// Only faults of the core thread outside of ScopedHostRamRead count as hits; the emulator's
+// own reads of main ram (rewind, savestates, IPC, recompiling) drop the page all the same.
+
+enum mmap_MemcheckPageFlags
+{
+	MemcheckPage_Read		= MEMCHECK_READ,
+	MemcheckPage_Write		= MEMCHECK_WRITE,
+	MemcheckPage_Disarmed	= 0x80,		// hit, protection dropped until the next event test
+};
+
+struct mmap_MemcheckHit
+{
+	u32 addr;
+	bool write;
+	bool onChange;		// only a hit if the line no longer matches 'line'
+	MemCheckResult result;
+	u128 line;			// the line as it was before the write, for onChange hits
+};
+
+static const uint MemcheckMaxHits = 16;
+
+static std::vector<MemCheck> m_Memchecks;		// page protected checks, standardized addresses
+static u8 m_PageMemcheck[Ps2MemSize::MainRam >> 12];
+static mmap_MemcheckHit m_MemcheckHits[MemcheckMaxHits];
+static uint m_MemcheckNumHits = 0;
+static bool m_MemcheckRearm = false;
+static int m_MemcheckHostReads = 0;			// core thread only
+
+// --------------------------------------------------------------------------------------
+//  Pinned ranges of main ram
+// --------------------------------------------------------------------------------------
+// Lets another thread read a range of main ram after the EE has moved on (zero-copy GIF
+// path 3 transfers read by the MTGS).  The pages of a pinned range are write protected
+// until the reader releases it.  A write to one of them before that first copies the
+// range aside and hands the copy to the reader, so the EE never waits on the reader
+// unless it is in the middle of reading the range.
+//
+// Pins are created and reclaimed by the EE thread under PageFault_Mutex; the reader only
+// flips the state of its pin.
+
+enum mmap_RamPinState
+{
+	RamPin_Free = 0,
+	RamPin_Pending,			// queued, the reader will read the ram
+	RamPin_Reading,			// the reader is reading the ram
+	RamPin_Copied,			// a write is coming, the reader will read the copy
+	RamPin_Done,			// released by the reader, pages not reclaimed yet
+};
+
+struct mmap_RamPin
+{
+	std::atomic<int> state;
+	u32 offset;
+	u32 size;
+	bool holdsPages;
+	std::vector<u8> copy;	// allocated when pinning, the fault handler must not allocate
+};
+
+static const uint RamPinMax = 16;
+
+static mmap_RamPin m_RamPins[RamPinMax];
+static u8 m_PagePins[Ps2MemSize::MainRam >> 12];
+
+// Host protection of a ram page: block tracking first, then pins and any armed memcheck.
+static void mmap_ApplyPageProtection( uint rampage )
+{
+	u8 memcheck = m_PageMemcheck[rampage];
+	if( memcheck & MemcheckPage_Disarmed ) memcheck = 0;
+
+	PageProtectionMode mode;
+	if( memcheck & MemcheckPage_Read )
+		mode = PageAccess_None();
+	else if( (memcheck & MemcheckPage_Write) || m_PagePins[rampage] || m_PageProtectInfo[rampage].Mode == ProtMode_Write )
+		mode = PageAccess_ReadOnly();
+	else
+		mode = PageAccess_ReadWrite();
+
+	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, mode );
+}
+
 
 // returns:
 //  ProtMode_NotRequired - unchecked block (resides in ROM, thus is integrity is constant)
@@ -950,7 +1165,7 @@ void mmap_MarkCountedRamPage( u32 paddr )
 	);
 
 	m_PageProtectInfo[rampage].Mode = ProtMode_Write;
-	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadOnly() );
+	mmap_ApplyPageProtection( rampage );
 }
 
 // offset - offset of address relative to psM.
@@ -967,8 +1182,8 @@ static __fi void mmap_ClearCpuBlock( uint offset )
 	pxAssertMsg( m_PageProtectInfo[rampage].Mode != ProtMode_Manual,
 		"Attempted to clear a block that is already under manual protection." );
 
-	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadWrite() );
 	m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
+	mmap_ApplyPageProtection( rampage );
 	Cpu->Clear( m_PageProtectInfo[rampage].ReverseRamMap, 0x400 );
 }
 
@@ -980,10 +1195,169 @@ void mmap_PageFaultHandler::OnPageFaultEvent( const PageFaultInfo& info, bool& h
 	uptr offset = info.addr - (uptr)eeMem->Main;
 	if( offset >= Ps2MemSize::MainRam ) return;
 
+	uint rampage = offset >> 12;
+	u8 memcheck = m_PageMemcheck[rampage];
+
+	// An armed memcheck page takes precedence; if the page is also write protected for
+	// block tracking, a write faults again right after and is handled below.
+	if( memcheck && !(memcheck & MemcheckPage_Disarmed) )
+	{
+		bool write = info.access == PageFaultAccess_Write;
+		u32 line = offset & ~0x0f;
+		bool guest = !m_MemcheckHostReads && GetCoreThread().IsSelf();
+
+		if( guest )
+		{
+			for( const MemCheck& check : m_Memchecks )
+			{
+				if( info.access != PageFaultAccess_Unknown && !(check.cond & (write ? (MEMCHECK_WRITE | MEMCHECK_WRITE_ONCHANGE) : MEMCHECK_READ)) )
+					continue;
+				if( line >= check.end || check.start >= line + 16 )
+					continue;
+
+				if( m_MemcheckNumHits < MemcheckMaxHits )
+				{
+					mmap_MemcheckHit& hit = m_MemcheckHits[m_MemcheckNumHits++];
+					hit.addr = offset;
+					hit.write = write;
+					hit.onChange = write && !(check.cond & MEMCHECK_WRITE);
+					hit.result = check.result;
+					if( hit.onChange ) memcpy( &hit.line, &eeMem->Main[line], sizeof(hit.line) );
+				}
+				break;
+			}
+		}
+
+		m_PageMemcheck[rampage] |= MemcheckPage_Disarmed;
+		m_MemcheckRearm = true;
+		mmap_ApplyPageProtection( rampage );
+		cpuSetEvent();
+
+		handled = true;
+		return;
+	}
+
+	// If the page is also write protected for block tracking, the write faults again.
+	if( mmap_HandlePinFault( rampage ) )
+	{
+		handled = true;
+		return;
+	}
+
 	mmap_ClearCpuBlock( offset );
 	handled = true;
 }
 
+// Rebuilds the memcheck pages from the debugger's memchecks.  Called by CBreakPoints::Update
+// with the EE paused.
+void mmap_UpdateMemchecks()
+{
+	Threading::ScopedLock lock( PageFault_Mutex );
+
+	std::vector<MemCheck> checks;
+	u8 pages[Ps2MemSize::MainRam >> 12] = {};
+
+	for( const MemCheck& check : CBreakPoints::GetMemChecks() )
+	{
+		if( !check.UsesPageProtection() ) continue;
+
+		MemCheck range = check;
+		range.start = standardizeBreakpointAddress( check.start );
+		range.end = standardizeBreakpointAddress( check.end );
+		checks.push_back( range );
+
+		u8 flags = 0;
+		if( check.cond & MEMCHECK_READ ) flags |= MemcheckPage_Read;
+		if( check.cond & (MEMCHECK_WRITE | MEMCHECK_WRITE_ONCHANGE) ) flags |= MemcheckPage_Write;
+
+		for( u32 page = range.start >> 12; page <= (range.end - 1) >> 12; ++page )
+			pages[page] |= flags;
+	}
+
+	m_Memchecks.swap( checks );
+	m_MemcheckNumHits = 0;
+	m_MemcheckRearm = false;
+
+	u8 changed[Ps2MemSize::MainRam >> 12];
+	for( uint rampage = 0; rampage < ArraySize(pages); ++rampage )
+	{
+		changed[rampage] = (m_PageMemcheck[rampage] & ~MemcheckPage_Disarmed) != pages[rampage]
+			|| (m_PageMemcheck[rampage] & MemcheckPage_Disarmed);
+
+		m_PageMemcheck[rampage] = pages[rampage];
+	}
+
+	if( !eeMem ) return;
+
+	// before the new memcheck pages are protected, see mmap_PinRamRange
+	mmap_DetachPinsOnMemchecks();
+
+	for( uint rampage = 0; rampage < ArraySize(pages); ++rampage )
+		if( changed[rampage] ) mmap_ApplyPageProtection( rampage );
+}
+
+static void mmap_DisarmMemchecks()
+{
+	if( !eeMem ) return;
+
+	for( uint rampage = 0; rampage < ArraySize(m_PageMemcheck); ++rampage )
+	{
+		if( !m_PageMemcheck[rampage] ) continue;
+
+		m_PageMemcheck[rampage] |= MemcheckPage_Disarmed;
+		m_MemcheckRearm = true;
+		HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadWrite() );
+	}
+}
+
+void mmap_BeginHostRead()
+{
+	++m_MemcheckHostReads;
+}
+
+void mmap_EndHostRead()
+{
+	pxAssert( m_MemcheckHostReads > 0 );
+	--m_MemcheckHostReads;
+}
+
+// Called from the EE event tests.  Logs the memchecks hit since the last call and re-arms
+// their pages.  Returns true if one of them wants to break into the debugger.
+bool mmap_TestMemchecks()
+{
+	if( !m_MemcheckRearm ) return false;
+
+	Threading::ScopedLock lock( PageFault_Mutex );
+
+	bool brk = false;
+	for( uint i = 0; i < m_MemcheckNumHits; ++i )
+	{
+		const mmap_MemcheckHit& hit = m_MemcheckHits[i];
+
+		// the store has completed by now
+		if( hit.onChange && memcmp( &hit.line, &eeMem->Main[hit.addr & ~0x0f], sizeof(hit.line) ) == 0 )
+			continue;
+
+		if( hit.result & MEMCHECK_LOG )
+			DevCon.WriteLn( hit.write ? "Hit store breakpoint @0x%x" : "Hit load breakpoint @0x%x", hit.addr );
+		if( hit.result & MEMCHECK_BREAK )
+			brk = true;
+	}
+
+	m_MemcheckNumHits = 0;
+	m_MemcheckRearm = false;
+
+	for( uint rampage = 0; rampage < ArraySize(m_PageMemcheck); ++rampage )
+	{
+		if( !(m_PageMemcheck[rampage] & MemcheckPage_Disarmed) ) continue;
+
+		m_PageMemcheck[rampage] &= ~MemcheckPage_Disarmed;
+		mmap_ApplyPageProtection( rampage );
+	}
+
+	return brk;
+}
+
 // Clears all block tracking statuses, manual protection flags, and write protection.
 // This does not clear any recompiler blocks.  It is assumed (and necessary) for the caller
 // to ensure the EErec is also reset in conjunction with calling this function.
@@ -993,4 +1367,158 @@ void mmap_ResetBlockTracking()
 	//DbgCon.WriteLn( "vtlb/mmap: Block Tracking reset..." );
 	memzero( m_PageProtectInfo );
 	if (eeMem) HostSys::MemProtect( eeMem->Main, Ps2MemSize::MainRam, PageAccess_ReadWrite() );
+
+	// keep the memchecks armed and the pins protected
+	for( uint rampage = 0; eeMem && rampage < ArraySize(m_PageMemcheck); ++rampage )
+	{
+		m_PageMemcheck[rampage] &= ~MemcheckPage_Disarmed;
+		if( m_PageMemcheck[rampage] || m_PagePins[rampage] ) mmap_ApplyPageProtection( rampage );
+	}
+}
+
+static void mmap_UnprotectPin( mmap_RamPin& pin )
+{
+	if( !pin.holdsPages ) return;
+	pin.holdsPages = false;
+
+	for( uint rampage = pin.offset >> 12; rampage <= (pin.offset + pin.size - 1) >> 12; ++rampage )
+	{
+		if( --m_PagePins[rampage] == 0 ) mmap_ApplyPageProtection( rampage );
+	}
+}
+
+// Makes sure the reader of the pin doesn't depend on main ram anymore.
+static void mmap_DetachPin( mmap_RamPin& pin )
+{
+	int state = pin.state.load( std::memory_order_acquire );
+
+	if( state == RamPin_Pending )
+	{
+		memcpy( pin.copy.data(), &eeMem->Main[pin.offset], pin.size );
+		if( pin.state.compare_exchange_strong( state, RamPin_Copied, std::memory_order_acq_rel ) )
+			state = RamPin_Copied;
+	}
+
+	while( state == RamPin_Reading )
+	{
+		Threading::SpinWait();
+		state = pin.state.load( std::memory_order_acquire );
+	}
+
+	mmap_UnprotectPin( pin );
+}
+
+static bool mmap_PinCoversMemcheck( const mmap_RamPin& pin )
+{
+	for( uint rampage = pin.offset >> 12; rampage <= (pin.offset + pin.size - 1) >> 12; ++rampage )
+		if( m_PageMemcheck[rampage] ) return true;
+
+	return false;
+}
+
+// Pins and memcheck pages don't mix: copying a pin aside would fault on a read memcheck
+// page with PageFault_Mutex held, and so would the reader.
+static void mmap_DetachPinsOnMemchecks()
+{
+	for( mmap_RamPin& pin : m_RamPins )
+		if( pin.holdsPages && mmap_PinCoversMemcheck( pin ) ) mmap_DetachPin( pin );
+}
+
+static bool mmap_HandlePinFault( uint rampage )
+{
+	if( !m_PagePins[rampage] ) return false;
+
+	for( mmap_RamPin& pin : m_RamPins )
+	{
+		if( !pin.holdsPages ) continue;
+		if( rampage < (pin.offset >> 12) || rampage > (pin.offset + pin.size - 1) >> 12 ) continue;
+
+		mmap_DetachPin( pin );
+	}
+
+	return true;
+}
+
+// Pins [ptr, ptr + size) if it lies in main ram.  Returns the pin to pass to the reader, or -1
+// if the range can't be pinned (the caller then copies the data).
+int mmap_PinRamRange( const u8* ptr, u32 size )
+{
+	if( !eeMem || !size ) return -1;
+
+	const uptr offset = (uptr)ptr - (uptr)eeMem->Main;
+	if( offset >= Ps2MemSize::MainRam || Ps2MemSize::MainRam - offset < size ) return -1;
+
+	Threading::ScopedLock lock( PageFault_Mutex );
+
+	int free = -1;
+	for( uint i = 0; i < RamPinMax; ++i )
+	{
+		mmap_RamPin& pin = m_RamPins[i];
+		if( pin.state.load( std::memory_order_acquire ) == RamPin_Done )
+		{
+			mmap_UnprotectPin( pin );
+			pin.state.store( RamPin_Free, std::memory_order_relaxed );
+		}
+		if( free < 0 && pin.state.load( std::memory_order_relaxed ) == RamPin_Free )
+			free = i;
+	}
+
+	if( free < 0 ) return -1;
+
+	mmap_RamPin& pin = m_RamPins[free];
+	pin.offset = (u32)offset;
+	pin.size = size;
+	if( mmap_PinCoversMemcheck( pin ) ) return -1;
+
+	if( pin.copy.size() < size ) pin.copy.resize( size );
+	pin.holdsPages = true;
+
+	for( uint rampage = pin.offset >> 12; rampage <= (pin.offset + size - 1) >> 12; ++rampage )
+	{
+		if( m_PagePins[rampage]++ == 0 ) mmap_ApplyPageProtection( rampage );
+	}
+
+	pin.state.store( RamPin_Pending, std::memory_order_release );
+	return free;
+}
+
+// Reader side: returns the data of the pin, which stays valid until mmap_ReleasePin.
+const u8* mmap_AcquirePin( int pin, u32& size )
+{
+	mmap_RamPin& p = m_RamPins[pin];
+	size = p.size;
+
+	int state = RamPin_Pending;
+	if( p.state.compare_exchange_strong( state, RamPin_Reading, std::memory_order_acq_rel ) )
+		return &eeMem->Main[p.offset];
+
+	pxAssert( state == RamPin_Copied );
+	return p.copy.data();
+}
+
+void mmap_ReleasePin( int pin )
+{
+	m_RamPins[pin].state.store( RamPin_Done, std::memory_order_release );
+}
+
+// Reader side: releases every pin it hasn't read yet, for when its queue is dropped
+// (MTGS ring reset) and it will never get to them.
+void mmap_ReleasePendingPins()
+{
+	for( mmap_RamPin& pin : m_RamPins )
+	{
+		int state = pin.state.load( std::memory_order_acquire );
+		while( (state == RamPin_Pending || state == RamPin_Copied)
+			&& !pin.state.compare_exchange_weak( state, RamPin_Done, std::memory_order_acq_rel ) ) {}
+	}
+}
+
+// Detaches every pin from main ram, for when the ram is about to be rewritten as a whole.
+static void mmap_DetachPins()
+{
+	if( !eeMem ) return;
+
+	Threading::ScopedLock lock( PageFault_Mutex );
+	for( mmap_RamPin& pin : m_RamPins )
+		mmap_DetachPin( pin );
 }
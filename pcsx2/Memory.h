@@ -127,6 +127,21 @@ enum vtlb_ProtectionMode
 extern vtlb_ProtectionMode mmap_GetRamPageInfo( u32 paddr );
 extern void mmap_MarkCountedRamPage( u32 paddr );
 extern void mmap_ResetBlockTracking();
+extern void mmap_UpdateMemchecks();
+extern bool mmap_TestMemchecks();
+extern void mmap_BeginHostRead();
+extern void mmap_EndHostRead();
+extern int mmap_PinRamRange( const u8* ptr, u32 size );
+extern const u8* mmap_AcquirePin( int pin, u32& size );
+extern void mmap_ReleasePin( int pin );
+extern void mmap_ReleasePendingPins();
+
+// Core thread reads of main ram done by the emulator itself, which memchecks don't report.
+struct ScopedHostRamRead
+{
+	ScopedHostRamRead() { mmap_BeginHostRead(); }
+	~ScopedHostRamRead() { mmap_EndHostRead(); }
+};
 
 #define memRead8 vtlb_memRead<mem8_t>
 #define memRead16 vtlb_memRead<mem16_t>
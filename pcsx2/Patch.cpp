@@ -28,14 +28,20 @@
 #include <wx/txtstrm.h>
 #include <wx/zipstrm.h>
 
-// This is a declaration for PatchMemory.cpp::_ApplyPatch where we're (patch.cpp)
-// the only consumer, so it's not made public via Patch.h
-// Applies a single patch line to emulation memory regardless of its "place" value.
-extern void _ApplyPatch(IniPatch *p);
+// These are declarations for PatchMemory.cpp::_CompilePatches/_ApplyCompiledPatches where
+// we're (patch.cpp) the only consumer, so they're not made public via Patch.h
+// _CompilePatches decodes the loaded patch lines of all places into flat op lists, and
+// returns the total number of ops.  _ApplyCompiledPatches runs the ops of one place.
+extern uint _CompilePatches(const std::vector<IniPatch>& patches);
+extern void _ApplyCompiledPatches(patch_place_type place);
 
 
 std::vector<IniPatch> Patch;
 
+// Patch lines are compiled on the first ApplyLoadedPatches after they change.
+static bool patchesCompiled = false;
+static PatchApplyStats patchStats;
+
 wxString strgametitle;
 
 struct PatchTextTable
@@ -174,7 +180,15 @@ void inifile_process(wxTextFile &f1 )
 
 void ForgetLoadedPatches()
 {
+	if (patchStats.Applications)
+	{
+		DevCon.WriteLn(L"(Patch) %u ops applied %u times, %ums in total",
+			patchStats.CompiledOps, patchStats.Applications, (u32)((patchStats.TotalTicks * 1000) / GetTickFrequency()));
+	}
+
 	Patch.clear();
+	patchesCompiled = false;
+	patchStats = PatchApplyStats();
 }
 
 static int _LoadPatchFiles(const wxDirName& folderName, wxString& fileSpec, const wxString& friendlyName, int& numberFoundPatchFiles)
@@ -340,6 +354,7 @@ namespace PatchFunc
 
 			iPatch.enabled = 1; // omg success!!
 			Patch.push_back(iPatch);
+			patchesCompiled = false;
 
 		}
 		catch( wxString& exmsg )
@@ -354,9 +369,22 @@ namespace PatchFunc
 // This is for applying patches directly to memory
 void ApplyLoadedPatches(patch_place_type place)
 {
-	for (auto& i : Patch)
+	if (!patchesCompiled)
 	{
-		if (i.placetopatch == place)
-			_ApplyPatch(&i);
+		patchStats.CompiledOps = _CompilePatches(Patch);
+		patchesCompiled = true;
 	}
+
+	u64 start = GetCPUTicks();
+	_ApplyCompiledPatches(place);
+	u64 elapsed = GetCPUTicks() - start;
+
+	patchStats.Applications++;
+	patchStats.LastTicks = elapsed;
+	patchStats.TotalTicks += elapsed;
+}
+
+PatchApplyStats GetPatchApplyStats()
+{
+	return patchStats;
 }
@@ -113,6 +113,19 @@ extern int  LoadPatchesFromZip(wxString gameCRC, const wxString& cheatsArchiveFi
 // (this happens at AppCoreThread::ApplySettings(...) )
 extern void ApplyLoadedPatches(patch_place_type place);
 
+// Timing of ApplyLoadedPatches since the patches were last loaded, in GetCPUTicks units.
+struct PatchApplyStats
+{
+	u32 CompiledOps;		// ops in the compiled lists of all places
+	u32 Applications;
+	u64 LastTicks;
+	u64 TotalTicks;
+
+	PatchApplyStats() : CompiledOps(0), Applications(0), LastTicks(0), TotalTicks(0) {}
+};
+
+extern PatchApplyStats GetPatchApplyStats();
+
 // Empties the patches store ("unload" the patches) but doesn't touch the emulation memory.
 // Following ApplyLoadedPatches calls will do nothing until some LoadPatchesFrom* are invoked.
 extern void ForgetLoadedPatches();
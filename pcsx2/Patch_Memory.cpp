@@ -19,6 +19,91 @@
 
 #include "IopCommon.h"
 #include "Patch.h"
+#include "vtlb.h"
+
+#include <vector>
+
+// --------------------------------------------------------------------------------------
+//  CompiledPatch
+// --------------------------------------------------------------------------------------
+// Patches are decoded once into a flat list of these (see _CompilePatches), so that the
+// per-vsync application doesn't have to re-interpret every IniPatch (and in particular
+// every extended cheat code) each time.
+
+enum PatchOpType
+{
+	PATCHOP_EE_WRITE8,
+	PATCHOP_EE_WRITE16,
+	PATCHOP_EE_WRITE32,
+	PATCHOP_EE_WRITE64,
+	PATCHOP_EE_RUN,			// contiguous EE writes, followed by the same writes as single ops
+	PATCHOP_IOP_WRITE8,
+	PATCHOP_IOP_WRITE16,
+	PATCHOP_IOP_WRITE32,
+	PATCHOP_EXTENDED,
+};
+
+// What an extended code line does when it isn't the continuation of a multi-line code.
+enum ExtendedOpType
+{
+	EXTOP_NOP,
+	EXTOP_WRITE8,			// 0aaaaaaa 000000vv
+	EXTOP_WRITE16,			// 1aaaaaaa 0000vvvv
+	EXTOP_WRITE32,			// 2aaaaaaa vvvvvvvv
+	EXTOP_INC8,				// 300000vv 0aaaaaaa
+	EXTOP_DEC8,				// 301000vv 0aaaaaaa
+	EXTOP_INC16,			// 3020vvvv 0aaaaaaa
+	EXTOP_DEC16,			// 3030vvvv 0aaaaaaa
+	EXTOP_BEGIN_INC32,		// 30400000 0aaaaaaa + Another line
+	EXTOP_BEGIN_DEC32,		// 30500000 0aaaaaaa + Another line
+	EXTOP_BEGIN_SERIAL,		// 4aaaaaaa nnnnssss + Another line
+	EXTOP_BEGIN_COPY,		// 5sssssss nnnnnnnn + Another line
+	EXTOP_BEGIN_POINTER,	// 6aaaaaaa 000000vv + Another line/s
+	EXTOP_OR8,				// 7aaaaaaa 000000vv
+	EXTOP_OR16,				// 7aaaaaaa 0010vvvv
+	EXTOP_AND8,				// 7aaaaaaa 002000vv
+	EXTOP_AND16,			// 7aaaaaaa 0030vvvv
+	EXTOP_XOR8,				// 7aaaaaaa 004000vv
+	EXTOP_XOR16,			// 7aaaaaaa 0050vvvv
+	EXTOP_SKIP8,			// E1yy00vv taaaaaaa
+	EXTOP_SKIP16,			// Daaaaaaa 00t0dddd / E0yyvvvv taaaaaaa
+};
+
+// Comparison of the conditional codes; the following lines are skipped when it holds.
+enum ExtendedSkipType
+{
+	EXTSKIP_NOT_EQUAL,
+	EXTSKIP_EQUAL,
+	EXTSKIP_GREATER_EQUAL,
+	EXTSKIP_LESS_EQUAL,
+};
+
+struct CompiledPatch
+{
+	u8	type;		// PatchOpType
+	u8	ext;		// ExtendedOpType (PATCHOP_EXTENDED only)
+	u8	cond;		// ExtendedSkipType (EXTOP_SKIP* only)
+	u8	skip;		// number of lines skipped (EXTOP_SKIP* only)
+
+	// Original patch address and data.  Continuation lines of extended codes are still
+	// interpreted from these.  For PATCHOP_EE_RUN, data is the count of single ops
+	// which follow it.
+	u32	addr;
+	u64	data;
+
+	// Pre-decoded operands: target address / value for extended codes, or offset into
+	// the run data / size in bytes for PATCHOP_EE_RUN.
+	u32	target;
+	u32	value;
+};
+
+struct CompiledPatchList
+{
+	std::vector<CompiledPatch>	ops;
+	std::vector<u8>				runData;
+};
+
+static CompiledPatchList s_compiledPatches[_PPT_END_MARKER];
 
 u32 SkipCount = 0, IterationCount = 0;
 u32 IterationIncrement = 0, ValueIncrement = 0;
@@ -42,13 +127,11 @@ void writeCheat()
 	}
 }
 
-void handle_extended_t(IniPatch *p)
+// Handles the second (and later) lines of the multi-line codes, where the meaning of a
+// line depends on the code that came before it rather than on its own prefix.
+static void handle_extended_continuation(const CompiledPatch* p)
 {
-	if (SkipCount > 0)
-	{
-		SkipCount--;
-	}
-	else switch (PrevCheatType)
+	switch (PrevCheatType)
 	{
 	case 0x3040: // vvvvvvvv 00000000 Inc
 	{
@@ -144,308 +227,435 @@ void handle_extended_t(IniPatch *p)
 		break;
 
 	default:
-		if ((p->addr & 0xF0000000) == 0x00000000)				// 0aaaaaaa 0000000vv
-		{
-			memWrite8(p->addr & 0x0FFFFFFF, (u8)p->data & 0x000000FF);
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xF0000000) == 0x10000000)			// 1aaaaaaa 0000vvvv
-		{
-			memWrite16(p->addr & 0x0FFFFFFF, (u16)p->data & 0x0000FFFF);
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xF0000000) == 0x20000000)			// 2aaaaaaa vvvvvvvv
-		{
-			memWrite32(p->addr & 0x0FFFFFFF, (u32)p->data);
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30000000)			// 300000vv 0aaaaaaa Inc
-		{
-			u8 mem = memRead8((u32)p->data);
-			memWrite8((u32)p->data, mem + (p->addr & 0x000000FF));
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30100000)			// 301000vv 0aaaaaaa Dec
-		{
-			u8 mem = memRead8((u32)p->data);
-			memWrite8((u32)p->data, mem - (p->addr & 0x000000FF));
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30200000)			// 3020vvvv 0aaaaaaa Inc
-		{
-			u16 mem = memRead16((u32)p->data);
-			memWrite16((u32)p->data, mem + (p->addr & 0x0000FFFF));
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30300000)			// 3030vvvv 0aaaaaaa Dec
-		{
-			u16 mem = memRead16((u32)p->data);
-			memWrite16((u32)p->data, mem - (p->addr & 0x0000FFFF));
-			PrevCheatType = 0;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30400000)			// 30400000 0aaaaaaa Inc + Another line
-		{
-			PrevCheatType = 0x3040;
-			PrevCheatAddr = (u32)p->data;
-		}
-		else if ((p->addr & 0xFFFF0000) == 0x30500000)			// 30500000 0aaaaaaa Inc + Another line
-		{
-			PrevCheatType = 0x3050;
-			PrevCheatAddr = (u32)p->data;
-		}
-		else if ((p->addr & 0xF0000000) == 0x40000000)			// 4aaaaaaa nnnnssss + Another line
+		break;
+	}
+}
+
+static void decode_extended(CompiledPatch& op)
+{
+	const u32 addr = op.addr;
+	const u32 data = (u32)op.data;
+
+	op.ext = EXTOP_NOP;
+
+	if ((addr & 0xF0000000) == 0x00000000)
+	{
+		op.ext = EXTOP_WRITE8;
+		op.target = addr & 0x0FFFFFFF;
+		op.value = data & 0x000000FF;
+	}
+	else if ((addr & 0xF0000000) == 0x10000000)
+	{
+		op.ext = EXTOP_WRITE16;
+		op.target = addr & 0x0FFFFFFF;
+		op.value = data & 0x0000FFFF;
+	}
+	else if ((addr & 0xF0000000) == 0x20000000)
+	{
+		op.ext = EXTOP_WRITE32;
+		op.target = addr & 0x0FFFFFFF;
+		op.value = data;
+	}
+	else if ((addr & 0xFFFF0000) == 0x30000000 || (addr & 0xFFFF0000) == 0x30100000)
+	{
+		op.ext = ((addr & 0xFFFF0000) == 0x30000000) ? EXTOP_INC8 : EXTOP_DEC8;
+		op.target = data;
+		op.value = addr & 0x000000FF;
+	}
+	else if ((addr & 0xFFFF0000) == 0x30200000 || (addr & 0xFFFF0000) == 0x30300000)
+	{
+		op.ext = ((addr & 0xFFFF0000) == 0x30200000) ? EXTOP_INC16 : EXTOP_DEC16;
+		op.target = data;
+		op.value = addr & 0x0000FFFF;
+	}
+	else if ((addr & 0xFFFF0000) == 0x30400000 || (addr & 0xFFFF0000) == 0x30500000)
+	{
+		op.ext = ((addr & 0xFFFF0000) == 0x30400000) ? EXTOP_BEGIN_INC32 : EXTOP_BEGIN_DEC32;
+		op.target = data;
+	}
+	else if ((addr & 0xF0000000) == 0x40000000)
+	{
+		op.ext = EXTOP_BEGIN_SERIAL;
+		op.target = addr & 0x0FFFFFFF;
+	}
+	else if ((addr & 0xF0000000) == 0x50000000)
+	{
+		op.ext = EXTOP_BEGIN_COPY;
+		op.target = addr & 0x0FFFFFFF;
+	}
+	else if ((addr & 0xF0000000) == 0x60000000)
+	{
+		op.ext = EXTOP_BEGIN_POINTER;
+		op.target = addr & 0x0FFFFFFF;
+	}
+	else if ((addr & 0xF0000000) == 0x70000000)
+	{
+		static const u8 bitwiseOps[] = { EXTOP_OR8, EXTOP_OR16, EXTOP_AND8, EXTOP_AND16, EXTOP_XOR8, EXTOP_XOR16 };
+		const u32 subtype = (data & 0x00F00000) >> 20;
+
+		if (subtype < ArraySize(bitwiseOps))
 		{
-			IterationCount = ((u32)p->data & 0xFFFF0000) / 0x10000;
-			IterationIncrement = ((u32)p->data & 0x0000FFFF) * 4;
-			PrevCheatAddr = (u32)p->addr & 0x0FFFFFFF;
-			PrevCheatType = 0x4000;
+			op.ext = bitwiseOps[subtype];
+			op.target = addr & 0x0FFFFFFF;
+			op.value = data & ((subtype & 1) ? 0x0000FFFF : 0x000000FF);
 		}
-		else if ((p->addr & 0xF0000000) == 0x50000000)			// 5sssssss nnnnnnnn + Another line
+	}
+	else if (addr < 0xE0000000)
+	{
+		// Daaaaaaa 00t0dddd, skips the next line.
+		if ((data & 0xFFCF0000) == 0)
 		{
-			PrevCheatAddr = (u32)p->addr & 0x0FFFFFFF;
-			IterationCount = ((u32)p->data);
-			PrevCheatType = 0x5000;
+			op.ext = EXTOP_SKIP16;
+			op.cond = (data >> 20) & 3;
+			op.skip = 1;
+			op.target = addr & 0x0FFFFFFF;
+			op.value = data & 0x0000FFFF;
 		}
-		else if ((p->addr & 0xF0000000) == 0x60000000)			// 6aaaaaaa 000000vv + Another line/s
+	}
+	else if (addr < 0xF0000000)
+	{
+		// Ezyyvvvv taaaaaaa, skips the next yy lines.
+		const u32 z = (addr & 0x0F000000) >> 24;
+
+		if ((data & 0xF0000000) <= 0x30000000 && z <= 1)
 		{
-			PrevCheatAddr = (u32)p->addr & 0x0FFFFFFF;
-			IterationIncrement = ((u32)p->data);
-			IterationCount = 0;
-			PrevCheatType = 0x6000;
+			op.ext = (z == 0) ? EXTOP_SKIP16 : EXTOP_SKIP8;
+			op.cond = data >> 28;
+			op.skip = (addr & 0x00FF0000) >> 16;
+			op.target = data & 0x0FFFFFFF;
+			op.value = addr & ((z == 0) ? 0x0000FFFF : 0x000000FF);
 		}
-		else if ((p->addr & 0xF0000000) == 0x70000000)
+	}
+}
+
+static __fi bool extended_skip_cond(u8 cond, u32 mem, u32 value)
+{
+	switch (cond)
+	{
+	case EXTSKIP_NOT_EQUAL:		return mem != value;
+	case EXTSKIP_EQUAL:			return mem == value;
+	case EXTSKIP_GREATER_EQUAL:	return mem >= value;
+	case EXTSKIP_LESS_EQUAL:	return mem <= value;
+	jNO_DEFAULT;
+	}
+	return false;
+}
+
+static void handle_extended_t(const CompiledPatch* p)
+{
+	if (SkipCount > 0)
+	{
+		SkipCount--;
+		return;
+	}
+
+	if (PrevCheatType != 0)
+	{
+		handle_extended_continuation(p);
+		return;
+	}
+
+	// PrevCheatType is known to be 0 from here on, so single-line codes don't need to
+	// reset it.
+	switch (p->ext)
+	{
+	case EXTOP_WRITE8:
+		memWrite8(p->target, (u8)p->value);
+		break;
+	case EXTOP_WRITE16:
+		memWrite16(p->target, (u16)p->value);
+		break;
+	case EXTOP_WRITE32:
+		memWrite32(p->target, p->value);
+		break;
+
+	case EXTOP_INC8:
+		memWrite8(p->target, memRead8(p->target) + p->value);
+		break;
+	case EXTOP_DEC8:
+		memWrite8(p->target, memRead8(p->target) - p->value);
+		break;
+	case EXTOP_INC16:
+		memWrite16(p->target, memRead16(p->target) + p->value);
+		break;
+	case EXTOP_DEC16:
+		memWrite16(p->target, memRead16(p->target) - p->value);
+		break;
+
+	case EXTOP_BEGIN_INC32:
+		PrevCheatType = 0x3040;
+		PrevCheatAddr = p->target;
+		break;
+	case EXTOP_BEGIN_DEC32:
+		PrevCheatType = 0x3050;
+		PrevCheatAddr = p->target;
+		break;
+	case EXTOP_BEGIN_SERIAL:
+		IterationCount = ((u32)p->data & 0xFFFF0000) / 0x10000;
+		IterationIncrement = ((u32)p->data & 0x0000FFFF) * 4;
+		PrevCheatAddr = p->target;
+		PrevCheatType = 0x4000;
+		break;
+	case EXTOP_BEGIN_COPY:
+		PrevCheatAddr = p->target;
+		IterationCount = ((u32)p->data);
+		PrevCheatType = 0x5000;
+		break;
+	case EXTOP_BEGIN_POINTER:
+		PrevCheatAddr = p->target;
+		IterationIncrement = ((u32)p->data);
+		IterationCount = 0;
+		PrevCheatType = 0x6000;
+		break;
+
+	case EXTOP_OR8:
+		memWrite8(p->target, (u8)(memRead8(p->target) | p->value));
+		break;
+	case EXTOP_OR16:
+		memWrite16(p->target, (u16)(memRead16(p->target) | p->value));
+		break;
+	case EXTOP_AND8:
+		memWrite8(p->target, (u8)(memRead8(p->target) & p->value));
+		break;
+	case EXTOP_AND16:
+		memWrite16(p->target, (u16)(memRead16(p->target) & p->value));
+		break;
+	case EXTOP_XOR8:
+		memWrite8(p->target, (u8)(memRead8(p->target) ^ p->value));
+		break;
+	case EXTOP_XOR16:
+		memWrite16(p->target, (u16)(memRead16(p->target) ^ p->value));
+		break;
+
+	case EXTOP_SKIP8:
+		if (extended_skip_cond(p->cond, memRead8(p->target), p->value))
+			SkipCount = p->skip;
+		break;
+	case EXTOP_SKIP16:
+		if (extended_skip_cond(p->cond, memRead16(p->target), p->value))
+			SkipCount = p->skip;
+		break;
+
+	default:
+		break;
+	}
+}
+
+// --------------------------------------------------------------------------------------
+//  Patch compilation
+// --------------------------------------------------------------------------------------
+
+static uint patch_write_size(patch_data_type type)
+{
+	switch (type)
+	{
+	case BYTE_T:	return 1;
+	case SHORT_T:	return 2;
+	case WORD_T:	return 4;
+	case DOUBLE_T:	return 8;
+	default:		return 0;
+	}
+}
+
+// Appends the single op for a plain (non-extended) patch line.
+static void compile_write(CompiledPatchList& list, const IniPatch& p)
+{
+	static const u8 eeOps[] = { PATCHOP_EE_WRITE8, PATCHOP_EE_WRITE16, PATCHOP_EE_WRITE32, PATCHOP_EE_WRITE64 };
+	static const u8 iopOps[] = { PATCHOP_IOP_WRITE8, PATCHOP_IOP_WRITE16, PATCHOP_IOP_WRITE32 };
+
+	CompiledPatch op = {};
+	op.addr = p.addr;
+	op.data = p.data;
+
+	const uint index = p.type - BYTE_T;
+	if (p.cpu == CPU_EE)
+		op.type = eeOps[index];
+	else if (index < ArraySize(iopOps))
+		op.type = iopOps[index];
+	else
+		return;		// IOP doubles were never supported.
+
+	list.ops.push_back(op);
+}
+
+// A run of EE writes to consecutive, naturally aligned addresses within the same page.
+// At apply time the whole run is checked and written with a single memcmp/memcpy when the
+// page is plain memory, otherwise the single ops that follow it are applied instead.
+struct PatchRun
+{
+	std::vector<const IniPatch*> patches;
+	u32 start;
+	u32 size;
+
+	bool CanAppend(const IniPatch& p, uint wsize) const
+	{
+		return !patches.empty() && p.addr == start + size && patches.size() < 0xFFFF &&
+			((p.addr + wsize - 1) >> vtlb_private::VTLB_PAGE_BITS) == (start >> vtlb_private::VTLB_PAGE_BITS);
+	}
+
+	void Flush(CompiledPatchList& list)
+	{
+		if (patches.size() > 1)
 		{
-			if ((p->data & 0x00F00000) == 0x00000000)			// 7aaaaaaa 000000vv
-			{
-				u8 mem = memRead8((u32)p->addr & 0x0FFFFFFF);
-				memWrite8((u32)p->addr & 0x0FFFFFFF, (u8)(mem | (p->data & 0x000000FF)));
-			}
-			else if ((p->data & 0x00F00000) == 0x00100000)		// 7aaaaaaa 0010vvvv
-			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				memWrite16((u32)p->addr & 0x0FFFFFFF, (u16)(mem | (p->data & 0x0000FFFF)));
-			}
-			else if ((p->data & 0x00F00000) == 0x00200000)		// 7aaaaaaa 002000vv
-			{
-				u8 mem = memRead8((u32)p->addr & 0x0FFFFFFF);
-				memWrite8((u32)p->addr & 0x0FFFFFFF, (u8)(mem & (p->data & 0x000000FF)));
-			}
-			else if ((p->data & 0x00F00000) == 0x00300000)		// 7aaaaaaa 0030vvvv
-			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				memWrite16((u32)p->addr & 0x0FFFFFFF, (u16)(mem & (p->data & 0x0000FFFF)));
-			}
-			else if ((p->data & 0x00F00000) == 0x00400000)		// 7aaaaaaa 004000vv
-			{
-				u8 mem = memRead8((u32)p->addr & 0x0FFFFFFF);
-				memWrite8((u32)p->addr & 0x0FFFFFFF, (u8)(mem ^ (p->data & 0x000000FF)));
-			}
-			else if ((p->data & 0x00F00000) == 0x00500000)		// 7aaaaaaa 0050vvvv
+			CompiledPatch op = {};
+			op.type = PATCHOP_EE_RUN;
+			op.addr = start;
+			op.data = patches.size();
+			op.target = list.runData.size();
+			op.value = size;
+			list.ops.push_back(op);
+
+			for (const IniPatch* p : patches)
 			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				memWrite16((u32)p->addr & 0x0FFFFFFF, (u16)(mem ^ (p->data & 0x0000FFFF)));
+				const uint wsize = patch_write_size(p->type);
+				const u8* bytes = (const u8*)&p->data;	// little endian, same as the PS2
+				list.runData.insert(list.runData.end(), bytes, bytes + wsize);
 			}
 		}
-		else if (p->addr < 0xE0000000)
+
+		for (const IniPatch* p : patches)
+			compile_write(list, *p);
+
+		patches.clear();
+		size = 0;
+	}
+};
+
+// Only used from Patch.cpp and we don't export this in any h file.
+// Patch.cpp itself declares this prototype, so make sure to keep in sync.
+// Rebuilds the compiled lists of all the places from the given patch lines.
+uint _CompilePatches(const std::vector<IniPatch>& patches)
+{
+	uint total = 0;
+
+	for (int place = 0; place < _PPT_END_MARKER; ++place)
+	{
+		CompiledPatchList& list = s_compiledPatches[place];
+		list.ops.clear();
+		list.runData.clear();
+
+		PatchRun run;
+		run.size = 0;
+
+		for (const IniPatch& p : patches)
 		{
-			if (((u32)p->data & 0xFFFF0000) == 0x00000000)		// Daaaaaaa 0000dddd
-			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				if (mem != (0x0000FFFF & (u32)p->data))
-				{
-					SkipCount = 1;
-				}
-				PrevCheatType = 0;
-			}
-			else if (((u32)p->data & 0xFFFF0000) == 0x00100000)	// Daaaaaaa 0010dddd
-			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				if (mem == (0x0000FFFF & (u32)p->data))
-				{
-					SkipCount = 1;
-				}
-				PrevCheatType = 0;
-			}
-			else if (((u32)p->data & 0xFFFF0000) == 0x00200000)	// Daaaaaaa 0020dddd
-			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				if (mem >= (0x0000FFFF & (u32)p->data))
-				{
-					SkipCount = 1;
-				}
-				PrevCheatType = 0;
-			}
-			else if (((u32)p->data & 0xFFFF0000) == 0x00300000)	// Daaaaaaa 0030dddd
+			if (p.enabled == 0 || p.placetopatch != place)
+				continue;
+
+			const uint wsize = patch_write_size(p.type);
+
+			if (p.cpu == CPU_EE && wsize && (p.addr & (wsize - 1)) == 0)
 			{
-				u16 mem = memRead16((u32)p->addr & 0x0FFFFFFF);
-				if (mem <= (0x0000FFFF & (u32)p->data))
+				if (!run.CanAppend(p, wsize))
 				{
-					SkipCount = 1;
+					run.Flush(list);
+					run.start = p.addr;
 				}
-				PrevCheatType = 0;
+				run.patches.push_back(&p);
+				run.size += wsize;
+				continue;
 			}
-		}
-		else if (p->addr < 0xF0000000)
-		{
-			if (((u32)p->data & 0xF0000000) == 0x00000000)		// Ezyyvvvv 0aaaaaaa
-			{
-				u8 z = ((u32)p->addr & 0x0F000000) / 0x01000000;
 
-				if (z == 0)											// E0yyvvvv 0aaaaaaa
-				{
-					u16 mem = memRead16((u32)p->data & 0x0FFFFFFF);
-					if (mem != (0x0000FFFF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-				else if (z == 1)									// E1yy00vv 0aaaaaaa
-				{
-					u8 mem = memRead8((u32)p->data & 0x0FFFFFFF);
-					if (mem != (0x000000FF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-			}
-			else if (((u32)p->data & 0xF0000000) == 0x10000000)	// Ezyyvvvv 1aaaaaaa
-			{
-				u8 z = ((u32)p->addr & 0x0F000000) / 0x01000000;
+			run.Flush(list);
 
-				if (z == 0)											// E0yyvvvv 1aaaaaaa
-				{
-					u16 mem = memRead16((u32)p->data & 0x0FFFFFFF);
-					if (mem == (0x0000FFFF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-				else if (z == 1)									// E1yy00vv 1aaaaaaa
-				{
-					u8 mem = memRead8((u32)p->data & 0x0FFFFFFF);
-					if (mem == (0x000000FF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-			}
-			else if (((u32)p->data & 0xF0000000) == 0x20000000)	// Ezyyvvvv 2aaaaaaa
+			if (p.cpu == CPU_EE && p.type == EXTENDED_T)
 			{
-				u8 z = ((u32)p->addr & 0x0F000000) / 0x01000000;
-
-				if (z == 0)											// E0yyvvvv 2aaaaaaa
-				{
-					u16 mem = memRead16((u32)p->data & 0x0FFFFFFF);
-					if (mem >= (0x0000FFFF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-				else if (z == 1)									// E1yy00vv 2aaaaaaa
-				{
-					u8 mem = memRead8((u32)p->data & 0x0FFFFFFF);
-					if (mem >= (0x000000FF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
+				CompiledPatch op = {};
+				op.type = PATCHOP_EXTENDED;
+				op.addr = p.addr;
+				op.data = p.data;
+				decode_extended(op);
+				list.ops.push_back(op);
 			}
-			else if (((u32)p->data & 0xF0000000) == 0x30000000)	// Ezyyvvvv 3aaaaaaa
+			else if ((p.cpu == CPU_EE || p.cpu == CPU_IOP) && wsize)
 			{
-				u8 z = ((u32)p->addr & 0x0F000000) / 0x01000000;
-
-				if (z == 0)											// E0yyvvvv 3aaaaaaa
-				{
-					u16 mem = memRead16((u32)p->data & 0x0FFFFFFF);
-					if (mem <= (0x0000FFFF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
-				else if (z == 1)									// E1yy00vv 3aaaaaaa
-				{
-					u8 mem = memRead8((u32)p->data & 0x0FFFFFFF);
-					if (mem <= (0x000000FF & (u32)p->addr))
-					{
-						SkipCount = ((u32)p->addr & 0x00FF0000) / 0x10000;
-					}
-					PrevCheatType = 0;
-				}
+				compile_write(list, p);
 			}
 		}
+
+		run.Flush(list);
+		total += list.ops.size();
 	}
+
+	return total;
 }
 
-// Only used from Patch.cpp and we don't export this in any h file.
-// Patch.cpp itself declares this prototype, so make sure to keep in sync.
-void _ApplyPatch(IniPatch *p)
+// Applies the compiled patch lines of the given place to emulation memory.
+void _ApplyCompiledPatches(patch_place_type place)
 {
-	if (p->enabled == 0) return;
+	using namespace vtlb_private;
+
+	const CompiledPatchList& list = s_compiledPatches[place];
+	const CompiledPatch* ops = list.ops.data();
+	const size_t count = list.ops.size();
 
-	switch (p->cpu)
+	for (size_t i = 0; i < count; ++i)
 	{
-	case CPU_EE:
+		const CompiledPatch* p = &ops[i];
+
 		switch (p->type)
 		{
-		case BYTE_T:
+		case PATCHOP_EE_WRITE8:
 			if (memRead8(p->addr) != (u8)p->data)
 				memWrite8(p->addr, (u8)p->data);
 			break;
 
-		case SHORT_T:
+		case PATCHOP_EE_WRITE16:
 			if (memRead16(p->addr) != (u16)p->data)
 				memWrite16(p->addr, (u16)p->data);
 			break;
 
-		case WORD_T:
+		case PATCHOP_EE_WRITE32:
 			if (memRead32(p->addr) != (u32)p->data)
 				memWrite32(p->addr, (u32)p->data);
 			break;
 
-		case DOUBLE_T:
+		case PATCHOP_EE_WRITE64:
+		{
 			u64 mem;
 			memRead64(p->addr, &mem);
 			if (mem != p->data)
 				memWrite64(p->addr, &p->data);
 			break;
+		}
 
-		case EXTENDED_T:
-			handle_extended_t(p);
-			break;
+		case PATCHOP_EE_RUN:
+		{
+			// Hardware registers and the interpreter's data cache need the single ops.
+			const VTLBVirtual vmv = vtlbdata.vmap[p->addr >> VTLB_PAGE_BITS];
+			if (vmv.isHandler(p->addr) || (!CHECK_EEREC && CHECK_CACHE))
+				break;
 
-		default:
+			u8* mem = (u8*)vmv.assumePtr(p->addr);
+			const u8* src = &list.runData[p->target];
+			if (memcmp(mem, src, p->value) != 0)
+				memcpy(mem, src, p->value);
+
+			i += p->data;
 			break;
 		}
-		break;
 
-	case CPU_IOP:
-		switch (p->type)
-		{
-		case BYTE_T:
+		case PATCHOP_IOP_WRITE8:
 			if (iopMemRead8(p->addr) != (u8)p->data)
 				iopMemWrite8(p->addr, (u8)p->data);
 			break;
-		case SHORT_T:
+
+		case PATCHOP_IOP_WRITE16:
 			if (iopMemRead16(p->addr) != (u16)p->data)
 				iopMemWrite16(p->addr, (u16)p->data);
 			break;
-		case WORD_T:
+
+		case PATCHOP_IOP_WRITE32:
 			if (iopMemRead32(p->addr) != (u32)p->data)
 				iopMemWrite32(p->addr, (u32)p->data);
 			break;
+
+		case PATCHOP_EXTENDED:
+			handle_extended_t(p);
+			break;
+
 		default:
 			break;
 		}
-		break;
-
-	default:
-		break;
 	}
 }
@@ -66,6 +66,7 @@ void Pcsx2Config::SpeedhackOptions::LoadSave( IniInterface& ini )
 	IniBitBool( WaitLoop );
 	IniBitBool( vuFlagHack );
 	IniBitBool( vuThread );
+	IniBitBool( iopThread );
 }
 
 void Pcsx2Config::ProfilerOptions::LoadSave( IniInterface& ini )
@@ -207,6 +208,7 @@ Pcsx2Config::GSOptions::GSOptions()
 #endif
 	FrameSkipEnable			= false;
 	VsyncEnable				= VsyncMode::Off;
+	PreciseFramePacing		= false;
 
 	SynchronousMTGS			= false;
 	VsyncQueueSize			= 2;
@@ -229,6 +231,7 @@ void Pcsx2Config::GSOptions::LoadSave( IniInterface& ini )
 	IniEntry( FrameLimitEnable );
 	IniEntry( FrameSkipEnable );
 	ini.EnumEntry( L"VsyncEnable", VsyncEnable, NULL, VsyncEnable );
+	IniEntry( PreciseFramePacing );
 
 	IniEntry( LimitScalar );
 	IniEntry( FramerateNTSC );
@@ -434,6 +437,9 @@ Pcsx2Config::Pcsx2Config()
 	McdFolderAutoManage = true;
 	EnablePatches = true;
 	BackupSavestate = true;
+
+	RewindInterval = 10;
+	RewindSnapshots = 60;
 }
 
 void Pcsx2Config::LoadSave( IniInterface& ini )
@@ -459,6 +465,10 @@ void Pcsx2Config::LoadSave( IniInterface& ini )
 	IniBitBool( MultitapPort0_Enabled );
 	IniBitBool( MultitapPort1_Enabled );
 
+	IniBitBool( EnableRewind );
+	IniEntry( RewindInterval );
+	IniEntry( RewindSnapshots );
+
 	// Process various sub-components:
 
 	Speedhacks		.LoadSave( ini );
@@ -17,6 +17,9 @@
 #include "PrecompiledHeader.h"
 #include "IopCommon.h"
 
+#include <atomic>
+#include <thread>
+
 #include "Sio.h"
 #include "Sif.h"
 
@@ -31,6 +34,9 @@ u32 g_psxHasConstReg, g_psxFlushedConstReg;
 // Controls when branch tests are performed.
 u32 g_iopNextEventCycle = 0;
 
+// Pending IOP events ordered by their deadline (see EventQueue.h).
+EventQueue iopEventQueue;
+
 // This value is used when the IOP execution is broken to return control to the EE.
 // (which happens when the IOP throws EE-bound interrupts).  It holds the value of
 // iopCycleEE (which is set to zero to facilitate the code break), so that the unrun
@@ -61,6 +67,7 @@ void psxReset()
 	iopBreak = 0;
 	iopCycleEE = -1;
 	g_iopNextEventCycle = psxRegs.cycle + 4;
+	iopEventQueue.Reset();
 
 	psxHwReset();
 	PSXCLK = 36864000;
@@ -142,9 +149,11 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 	psxRegs.sCycle[n] = psxRegs.cycle;
 	psxRegs.eCycle[n] = ecycle;
 
+	iopEventQueue.Schedule( n, psxRegs.sCycle[n] + psxRegs.eCycle[n] );
+
 	psxSetNextBranchDelta( ecycle );
 
-	if( iopCycleEE < 0 )
+	if( iopCycleEE < 0 && !iopThreadIsCurrent() )
 	{
 		// The EE called this int, so inform it to branch as needed:
 		// fixme - this doesn't take into account EE/IOP sync (the IOP may be running
@@ -154,43 +163,85 @@ __fi void PSX_INT( IopEventId n, s32 ecycle )
 	}
 }
 
-static __fi void IopTestEvent( IopEventId n, void (*callback)() )
+// Same as cpuGetDueInts on the EE side: pops the due events off the queue and schedules the
+// next branch test on the nearest one that isn't.
+static __fi u32 psxGetDueInts()
 {
-	if( !(psxRegs.interrupt & (1 << n)) ) return;
+	// Pending events the queue doesn't know of (savestate loads, SIO while HW_ICFG masks it)
+	u32 missing = psxRegs.interrupt & ~iopEventQueue.GetQueued();
 
-	if( psxTestCycle( psxRegs.sCycle[n], psxRegs.eCycle[n] ) )
+	for( uint n = 0; missing != 0; n++, missing >>= 1 )
 	{
-		psxRegs.interrupt &= ~(1 << n);
-		callback();
+		if( missing & 1 )
+			iopEventQueue.Schedule( n, psxRegs.sCycle[n] + psxRegs.eCycle[n] );
 	}
-	else
-		psxSetNextBranch( psxRegs.sCycle[n], psxRegs.eCycle[n] );
+
+	u32 due = 0;
+
+	while( !iopEventQueue.IsEmpty() )
+	{
+		uint n = iopEventQueue.Top();
+
+		if( !(psxRegs.interrupt & (1 << n)) )
+			iopEventQueue.Remove( n );
+		else if( iopEventQueue.TopDeadline() != psxRegs.sCycle[n] + psxRegs.eCycle[n] )
+			iopEventQueue.Schedule( n, psxRegs.sCycle[n] + psxRegs.eCycle[n] );
+		else if( psxTestCycle( psxRegs.sCycle[n], psxRegs.eCycle[n] ) )
+		{
+			iopEventQueue.Remove( n );
+			due |= 1 << n;
+		}
+		else
+		{
+			psxSetNextBranch( psxRegs.sCycle[n], psxRegs.eCycle[n] );
+			break;
+		}
+	}
+
+	return due;
+}
+
+static __fi void IopTestEvent( u32 due, IopEventId n, void (*callback)() )
+{
+	if( !(due & (1 << n)) ) return;
+	if( !(psxRegs.interrupt & (1 << n)) ) return;
+	if( !psxTestCycle( psxRegs.sCycle[n], psxRegs.eCycle[n] ) )
+	{
+		// Postponed by writing eCycle[n] directly; it was popped as due, so put it back.
+		iopEventQueue.Schedule( n, psxRegs.sCycle[n] + psxRegs.eCycle[n] );
+		return;
+	}
+
+	psxRegs.interrupt &= ~(1 << n);
+	iopEventQueue.Remove( n );
+	iopEventQueue.Fired++;
+	callback();
 }
 
 static __fi void _psxTestInterrupts()
 {
-	IopTestEvent(IopEvt_SIF0,		sif0Interrupt);	// SIF0
-	IopTestEvent(IopEvt_SIF1,		sif1Interrupt);	// SIF1
-	IopTestEvent(IopEvt_SIF2,		sif2Interrupt);	// SIF2
-	// Originally controlled by a preprocessor define, now PSX dependent.
-	if (psxHu32(HW_ICFG) & (1 << 3)) IopTestEvent(IopEvt_SIO, sioInterruptR);
-	IopTestEvent(IopEvt_CdvdRead,	cdvdReadInterrupt);
+	u32 due = psxGetDueInts();
 
-	// Profile-guided Optimization (sorta)
-	// The following ints are rarely called.  Encasing them in a conditional
-	// as follows helps speed up most games.
+	if( !due ) return;
 
-	if( psxRegs.interrupt & ((1 << IopEvt_Cdvd) | (1 << IopEvt_Dma11) | (1 << IopEvt_Dma12)
-		| (1 << IopEvt_Cdrom) | (1 << IopEvt_CdromRead) | (1 << IopEvt_DEV9) | (1 << IopEvt_USB)))
-	{
-		IopTestEvent(IopEvt_Cdvd,		cdvdActionInterrupt);
-		IopTestEvent(IopEvt_Dma11,		psxDMA11Interrupt);	// SIO2
-		IopTestEvent(IopEvt_Dma12,		psxDMA12Interrupt);	// SIO2
-		IopTestEvent(IopEvt_Cdrom,		cdrInterrupt);
-		IopTestEvent(IopEvt_CdromRead,	cdrReadInterrupt);
-		IopTestEvent(IopEvt_DEV9,		dev9Interrupt);
-		IopTestEvent(IopEvt_USB,		usbInterrupt);
-	}
+	IopTestEvent(due, IopEvt_SIF0,		sif0Interrupt);	// SIF0
+	IopTestEvent(due, IopEvt_SIF1,		sif1Interrupt);	// SIF1
+	IopTestEvent(due, IopEvt_SIF2,		sif2Interrupt);	// SIF2
+	// Originally controlled by a preprocessor define, now PSX dependent.
+	if (psxHu32(HW_ICFG) & (1 << 3)) IopTestEvent(due, IopEvt_SIO, sioInterruptR);
+	IopTestEvent(due, IopEvt_CdvdRead,	cdvdReadInterrupt);
+
+	IopTestEvent(due, IopEvt_Cdvd,		cdvdActionInterrupt);
+	IopTestEvent(due, IopEvt_Dma11,		psxDMA11Interrupt);	// SIO2
+	IopTestEvent(due, IopEvt_Dma12,		psxDMA12Interrupt);	// SIO2
+	IopTestEvent(due, IopEvt_Cdrom,		cdrInterrupt);
+	IopTestEvent(due, IopEvt_CdromRead,	cdrReadInterrupt);
+	IopTestEvent(due, IopEvt_DEV9,		dev9Interrupt);
+	IopTestEvent(due, IopEvt_USB,		usbInterrupt);
+
+	// Same as on the EE side, the callbacks may have changed what's nearest.
+	if( !iopEventQueue.IsEmpty() )
+		psxSetNextBranch( psxRegs.cycle, (s32)(iopEventQueue.TopDeadline() - psxRegs.cycle) );
 }
 
 __ri void iopEventTest()
@@ -231,7 +282,9 @@ void iopTestIntc()
 	if( psxHu32(0x1078) == 0 ) return;
 	if( (psxHu32(0x1070) & psxHu32(0x1074)) == 0 ) return;
 
-	if( !eeEventTestIsActive )
+	// On the IOP thread the EE's event scheduling isn't ours to touch; branch the IOP
+	// itself, the slice returns to the EE at its next event test regardless.
+	if( !eeEventTestIsActive && !iopThreadIsCurrent() )
 	{
 		// An iop exception has occurred while the EE is running code.
 		// Inform the EE to branch so the IOP can handle it promptly:
@@ -247,3 +300,174 @@ void iopTestIntc()
 		psxSetNextBranchDelta( 2 );
 }
 
+// --------------------------------------------------------------------------------------
+//  Threaded IOP
+// --------------------------------------------------------------------------------------
+// Experimental (Speedhacks.iopThread, ini only).  Instead of running the IOP timeslice
+// inline at the end of the EE event test, the EE hands it to the IOP thread and goes on
+// with its own code.  Ownership is simple: while a slice is in flight the IOP thread owns
+// psxRegs, IOP memory and the IOP-side devices, the EE thread owns everything else.  Both
+// sides meet at the points where that isn't true:
+//
+//  * The EE joins the slice at the start of its next event test, so counters, IOP event
+//    tests and the scheduling math always see an idle IOP.  The EE schedules that event
+//    test at most iopThreadMaxSkew cycles out, which bounds how far apart the two cpus
+//    drift (R5900.cpp).
+//
+//  * The EE joins before touching SIF/SBUS registers or starting a SIF DMA, and on reset.
+//
+//  * The IOP waits for the EE to park (in a join) before touching SBUS registers or SIF
+//    DMA/FIFO state.  A parked EE stays parked until the slice ends, so once the IOP has
+//    synced it can call into EE-side code (SIF DMAC irqs, CPU_INT) just like the inline
+//    IOP does.
+//
+// PS1 mode runs the IOP inline; the EE is only a PGIF helper there and syncs constantly.
+
+static std::thread s_iopThread;
+static Threading::Semaphore s_iopThreadWake;
+static std::atomic<bool> s_iopThreadSleeping( false );
+static std::atomic<bool> s_iopThreadExit( false );
+
+// Slices are numbered; the IOP thread runs a slice when s_sliceQueued moves ahead of
+// s_sliceDone, and publishes its results by advancing s_sliceDone.
+static std::atomic<u32> s_sliceQueued( 0 );
+static std::atomic<u32> s_sliceDone( 0 );
+static std::atomic<bool> s_eeParked( false );
+static s32 s_sliceCycles;
+static ScopedExcept s_sliceException;
+
+// EE thread only: a slice was launched and hasn't been joined yet.
+static bool s_sliceRunning = false;
+
+static DeclareTls(bool) s_onIopThread = false;
+
+// Returns false when the thread is asked to exit.
+static bool iopThreadWaitForSlice( u32 done )
+{
+	// Slices usually follow each other within a few microseconds, so spin a bit before
+	// going to sleep.
+	for( int spin = 0; s_sliceQueued.load( std::memory_order_acquire ) == done; ++spin )
+	{
+		if( s_iopThreadExit.load( std::memory_order_relaxed ) ) return false;
+		if( spin < 2048 ) { Threading::SpinWait(); continue; }
+
+		s_iopThreadSleeping.store( true );
+		if( s_sliceQueued.load() == done && !s_iopThreadExit.load() )
+			s_iopThreadWake.WaitWithoutYield();
+		s_iopThreadSleeping.store( false );
+		spin = 0;
+	}
+
+	return true;
+}
+
+static void iopThreadRunSlice()
+{
+	try {
+		s_sliceCycles = psxCpu->ExecuteBlock( s_sliceCycles );
+	}
+	catch( BaseException& ex )
+	{
+		s_sliceException = ScopedExcept( ex.Clone() );
+	}
+}
+
+static void iopThreadLoop()
+{
+	u32 done = s_sliceDone.load( std::memory_order_relaxed );
+
+	while( iopThreadWaitForSlice( done ) )
+	{
+		iopThreadRunSlice();
+		s_sliceDone.store( ++done, std::memory_order_release );
+	}
+}
+
+static void iopThreadMain()
+{
+	s_onIopThread = true;
+
+	PCSX2_PAGEFAULT_PROTECT {
+		iopThreadLoop();
+	} PCSX2_PAGEFAULT_EXCEPT;
+}
+
+void iopThreadLaunch( s32 eeCycles )
+{
+	pxAssert( !s_sliceRunning );
+
+	if( !s_iopThread.joinable() )
+	{
+		s_iopThreadExit = false;
+		s_iopThread = std::thread( iopThreadMain );
+	}
+
+	s_sliceCycles = eeCycles;
+	s_sliceRunning = true;
+	s_sliceQueued.fetch_add( 1 );
+
+	if( s_iopThreadSleeping.exchange( false ) )
+		s_iopThreadWake.Post();
+}
+
+static void iopThreadWaitSlice()
+{
+	s_eeParked.store( true, std::memory_order_release );
+
+	const u32 queued = s_sliceQueued.load( std::memory_order_relaxed );
+	for( int spin = 0; s_sliceDone.load( std::memory_order_acquire ) != queued; ++spin )
+	{
+		if( spin < 4096 ) Threading::SpinWait();
+		else Threading::Timeslice();
+	}
+
+	s_eeParked.store( false, std::memory_order_relaxed );
+	s_sliceRunning = false;
+
+	// Same as the inline EEsCycle = psxCpu->ExecuteBlock( EEsCycle )
+	EEsCycle = s_sliceCycles;
+}
+
+void iopThreadJoin()
+{
+	if( !s_sliceRunning ) return;
+
+	iopThreadWaitSlice();
+
+	if( s_sliceException )
+	{
+		ScopedExcept ex( std::move( s_sliceException ) );
+		ex->Rethrow();
+	}
+}
+
+void iopThreadSyncEE()
+{
+	if( !s_onIopThread ) return;
+
+	while( !s_eeParked.load( std::memory_order_acquire ) )
+		Threading::SpinWait();
+}
+
+void iopThreadShutdown()
+{
+	if( s_sliceRunning ) iopThreadWaitSlice();
+	s_sliceException = nullptr;
+
+	if( !s_iopThread.joinable() ) return;
+
+	s_iopThreadExit = true;
+	s_iopThreadWake.Post();
+	s_iopThread.join();
+}
+
+// True on the EE thread while a slice is in flight (IOP state is off limits).
+bool iopThreadBusy()
+{
+	return !s_onIopThread && s_sliceRunning;
+}
+
+bool iopThreadIsCurrent()
+{
+	return s_onIopThread;
+}
@@ -17,6 +17,7 @@
 #define __R3000A_H__
 
 #include <stdio.h>
+#include "EventQueue.h"
 
 union GPRRegs {
 	struct {
@@ -118,6 +119,7 @@ struct psxRegisters {
 extern __aligned16 psxRegisters psxRegs;
 
 extern u32 g_iopNextEventCycle;
+extern EventQueue iopEventQueue;
 extern s32 iopBreak;		// used when the IOP execution is broken and control returned to the EE
 extern s32 iopCycleEE;		// tracks IOP's current sych status with the EE
 
@@ -198,11 +200,23 @@ extern R3000Acpu *psxCpu;
 extern R3000Acpu psxInt;
 extern R3000Acpu psxRec;
 
+extern void recPrintIopBlockProfile();
+
 extern void psxReset();
 extern void __fastcall psxException(u32 code, u32 step);
 extern void iopEventTest();
 extern void psxMemReset();
 
+// Threaded IOP (Speedhacks.iopThread, see R3000A.cpp).  The EE hands each IOP timeslice
+// to a second host thread and keeps running; the slice is joined at the next EE event
+// test, or earlier when either cpu touches state shared with the other.
+extern void iopThreadLaunch( s32 eeCycles );
+extern void iopThreadJoin();
+extern void iopThreadSyncEE();
+extern void iopThreadShutdown();
+extern bool iopThreadBusy();
+extern bool iopThreadIsCurrent();
+
 // Subsets
 extern void (*psxBSC[64])();
 extern void (*psxSPC[64])();
@@ -123,6 +123,63 @@ void psxJALR()
 	doBranch(_u32(_rRs_));
 }
 
+// --------------------------------------------------------------------------------------
+//  Decoded instruction cache
+// --------------------------------------------------------------------------------------
+// Instructions in iop ram and the bios are decoded once into their final handler, so execI
+// skips both the fetch and the psxSPECIAL/psxREGIMM/psxCOP0/psxCOP2 second level dispatch.
+// Iop stores and DMAs already report every write to psxCpu->Clear, which drops the affected
+// words from the cache (the same notification the recompiler relies on).
+
+struct psxDecodedOp
+{
+	u32		code;
+	void	(*interpret)();		// NULL until the word is decoded
+};
+
+static const uint psxDecodedPageOps = 0x1000 / 4;
+
+static std::unique_ptr<psxDecodedOp[]> s_ramDecoded[Ps2MemSize::IopRam >> 12];
+static std::unique_ptr<psxDecodedOp[]> s_romDecoded[Ps2MemSize::Rom >> 12];
+
+// virtual page of the last lookup, and its decoded page (NULL when it uses the plain fetch)
+static u32 s_curVPage = ~0u;
+static psxDecodedOp* s_curPage = NULL;
+
+static void (*psxDecode(u32 code))()
+{
+	switch (code >> 26)
+	{
+		case 0: return psxSPC[code & 0x3f];
+		case 1: return psxREG[(code >> 16) & 0x1f];
+		case 16: return psxCP0[(code >> 21) & 0x1f];
+		case 18: return (code & 0x3f) ? psxCP2[code & 0x3f] : psxCP2BSC[(code >> 21) & 0x1f];
+	}
+	return psxBSC[code >> 26];
+}
+
+static psxDecodedOp* psxGetDecodedPage(std::unique_ptr<psxDecodedOp[]>& page)
+{
+	if (!page) page = std::make_unique<psxDecodedOp[]>(psxDecodedPageOps);
+	return page.get();
+}
+
+static psxDecodedOp* psxLookupPage(u32 pc)
+{
+	const u8* ptr = iopVirtMemR<u8>(pc & ~0xfff);
+	if (!ptr) return NULL;
+
+	uptr offset = (uptr)ptr - (uptr)iopMem->Main;
+	if (offset < Ps2MemSize::IopRam)
+		return psxGetDecodedPage(s_ramDecoded[offset >> 12]);
+
+	offset = (uptr)ptr - (uptr)eeMem->ROM;
+	if (offset < Ps2MemSize::Rom)
+		return psxGetDecodedPage(s_romDecoded[offset >> 12]);
+
+	return NULL;
+}
+
 ///////////////////////////////////////////
 // These macros are used to assemble the repassembler functions
 
@@ -136,7 +193,29 @@ static __fi void execI()
 		}
 	}
 
-	psxRegs.code = iopMemRead32(psxRegs.pc);
+	if ((psxRegs.pc >> 12) != s_curVPage)
+	{
+		s_curVPage = psxRegs.pc >> 12;
+		s_curPage = psxLookupPage(psxRegs.pc);
+	}
+
+	void (*interpret)();
+	if (s_curPage)
+	{
+		psxDecodedOp& op = s_curPage[(psxRegs.pc >> 2) & (psxDecodedPageOps - 1)];
+		if (!op.interpret)
+		{
+			op.code = iopMemRead32(psxRegs.pc);
+			op.interpret = psxDecode(op.code);
+		}
+		psxRegs.code = op.code;
+		interpret = op.interpret;
+	}
+	else
+	{
+		psxRegs.code = iopMemRead32(psxRegs.pc);
+		interpret = psxBSC[psxRegs.code >> 26];
+	}
 
 		PSXCPU_LOG("%s", disR3000AF(psxRegs.code, psxRegs.pc));
 
@@ -152,7 +231,7 @@ static __fi void execI()
 	{   //default ps2 mode value
 		iopCycleEE-=8;
 	}
-	psxBSC[psxRegs.code >> 26]();
+	interpret();
 }
 
 static void doBranch(s32 tar) {
@@ -174,6 +253,14 @@ static void intAlloc() {
 
 static void intReset() {
 	intAlloc();
+
+	for (uint i = 0; i < ArraySize(s_ramDecoded); ++i)
+		if (s_ramDecoded[i]) memset(s_ramDecoded[i].get(), 0, sizeof(psxDecodedOp) * psxDecodedPageOps);
+	for (uint i = 0; i < ArraySize(s_romDecoded); ++i)
+		if (s_romDecoded[i]) memset(s_romDecoded[i].get(), 0, sizeof(psxDecodedOp) * psxDecodedPageOps);
+
+	s_curVPage = ~0u;
+	s_curPage = NULL;
 }
 
 static void intExecute() {
@@ -198,6 +285,16 @@ static s32 intExecuteBlock( s32 eeCycles )
 }
 
 static void intClear(u32 Addr, u32 Size) {
+	// Only iop ram is writable; it is mirrored every 2MB up to 8MB in each segment.
+	for (u32 i = 0; i < Size; ++i)
+	{
+		u32 addr = Addr + i * 4;
+		if ((addr & 0x1fffffff) >= 0x800000) continue;
+
+		const u32 offset = addr & (Ps2MemSize::IopRam - 1);
+		if (psxDecodedOp* page = s_ramDecoded[offset >> 12].get())
+			page[(offset >> 2) & (psxDecodedPageOps - 1)].interpret = NULL;
+	}
 }
 
 static void intShutdown() {
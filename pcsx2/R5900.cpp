@@ -71,6 +71,7 @@ extern SysMainMemory& GetVmMemory();
 
 void cpuReset()
 {
+	iopThreadShutdown();
 	vu1Thread.WaitVU();
 	if (GetMTGS().IsOpen())
 		GetMTGS().WaitGS();		// GS better be done processing before we reset the EE, just in case.
@@ -89,6 +90,7 @@ void cpuReset()
 	fpuRegs.fprc[31]		= 0x01000001; // fpu Status/Control
 
 	g_nextEventCycle = cpuRegs.cycle + 4;
+	eeEventQueue.Reset();
 	EEsCycle = 0;
 	EEoCycle = cpuRegs.cycle;
 
@@ -259,23 +261,79 @@ __fi void cpuSetEvent()
 	g_nextEventCycle = cpuRegs.cycle;
 }
 
+// Pending DMAC/VIF events ordered by their deadline (see EventQueue.h).
+EventQueue eeEventQueue;
+
+// The events _cpuTestInterrupts dispatches.  Anything else raised with CPU_INT (SIF2) is
+// never dispatched on the EE side, so it is kept out of the queue and just stays pending.
+static const u32 eeQueuedEvents =
+	(1 << DMAC_VIF0) | (1 << DMAC_VIF1) | (1 << DMAC_GIF) | (1 << DMAC_FROM_IPU) | (1 << DMAC_TO_IPU)
+	| (1 << DMAC_SIF0) | (1 << DMAC_SIF1) | (1 << DMAC_FROM_SPR) | (1 << DMAC_TO_SPR)
+	| (1 << DMAC_MFIFO_VIF) | (1 << DMAC_MFIFO_GIF) | (1 << VIF_VU0_FINISH) | (1 << VIF_VU1_FINISH);
+
 __fi void cpuClearInt( uint i )
 {
 	pxAssume( i < 32 );
 	cpuRegs.interrupt &= ~(1 << i);
+	eeEventQueue.Remove( i );
 }
 
-static __fi void TESTINT( u8 n, void (*callback)() )
+// Pops every event that is due off the queue and returns them as a mask, then schedules the
+// next event test on the nearest one that isn't.  Entries are checked against cpuRegs first,
+// since some DMA code clears the interrupt bits or postpones eCycle[n] directly.
+static __fi u32 cpuGetDueInts()
 {
-	if( !(cpuRegs.interrupt & (1 << n)) ) return;
+	// Pending events the queue doesn't know of: the queue was reset by a savestate load, or
+	// a previous pass left them pending (DMAC disabled).
+	u32 missing = cpuRegs.interrupt & eeQueuedEvents & ~eeEventQueue.GetQueued();
 
-	if( cpuTestCycle( cpuRegs.sCycle[n], cpuRegs.eCycle[n] ) )
+	for( uint n = 0; missing != 0; n++, missing >>= 1 )
 	{
-		cpuClearInt( n );
-		callback();
+		if( missing & 1 )
+			eeEventQueue.Schedule( n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n] );
 	}
-	else
-		cpuSetNextEvent( cpuRegs.sCycle[n], cpuRegs.eCycle[n] );
+
+	u32 due = 0;
+
+	while( !eeEventQueue.IsEmpty() )
+	{
+		uint n = eeEventQueue.Top();
+
+		if( !(cpuRegs.interrupt & (1 << n)) )
+			eeEventQueue.Remove( n );
+		else if( eeEventQueue.TopDeadline() != cpuRegs.sCycle[n] + cpuRegs.eCycle[n] )
+			eeEventQueue.Schedule( n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n] );
+		else if( cpuTestCycle( cpuRegs.sCycle[n], cpuRegs.eCycle[n] ) )
+		{
+			eeEventQueue.Remove( n );
+			due |= 1 << n;
+		}
+		else
+		{
+			cpuSetNextEvent( cpuRegs.sCycle[n], cpuRegs.eCycle[n] );
+			break;
+		}
+	}
+
+	return due;
+}
+
+static __fi void TESTINT( u32 due, u8 n, void (*callback)() )
+{
+	if( !(due & (1 << n)) ) return;
+
+	// A callback earlier in this pass may have cleared or rescheduled it (CPU_INT requeues it then).
+	if( !(cpuRegs.interrupt & (1 << n)) ) return;
+	if( !cpuTestCycle( cpuRegs.sCycle[n], cpuRegs.eCycle[n] ) )
+	{
+		// Postponed by writing eCycle[n] directly; it was popped as due, so put it back.
+		eeEventQueue.Schedule( n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n] );
+		return;
+	}
+
+	cpuClearInt( n );
+	eeEventQueue.Fired++;
+	callback();
 }
 
 // [TODO] move this function to LegacyDmac.cpp, and remove most of the DMAC-related headers from
@@ -290,33 +348,35 @@ static __fi void _cpuTestInterrupts()
 	/* These are 'pcsx2 interrupts', they handle asynchronous stuff
 	   that depends on the cycle timings */
 
-	TESTINT(DMAC_VIF1,		vif1Interrupt);	
-	TESTINT(DMAC_GIF,		gifInterrupt);
-	TESTINT(DMAC_SIF0,		EEsif0Interrupt);
-	TESTINT(DMAC_SIF1,		EEsif1Interrupt);
-	
-	// Profile-guided Optimization (sorta)
-	// The following ints are rarely called.  Encasing them in a conditional
-	// as follows helps speed up most games.
+	u32 due = cpuGetDueInts();
 
-	if (cpuRegs.interrupt & ((1 << DMAC_VIF0) | (1 << DMAC_FROM_IPU) | (1 << DMAC_TO_IPU)
-		| (1 << DMAC_FROM_SPR) | (1 << DMAC_TO_SPR) | (1 << DMAC_MFIFO_VIF) | (1 << DMAC_MFIFO_GIF)
-		| (1 << VIF_VU0_FINISH) | (1 << VIF_VU1_FINISH)))
-	{
-		TESTINT(DMAC_VIF0,		vif0Interrupt);
+	if( !due ) return;
 
-		TESTINT(DMAC_FROM_IPU,	ipu0Interrupt);
-		TESTINT(DMAC_TO_IPU,	ipu1Interrupt);
+	// Whatever is due is still dispatched in the usual channel order, not in deadline order.
 
-		TESTINT(DMAC_FROM_SPR,	SPRFROMinterrupt);
-		TESTINT(DMAC_TO_SPR,	SPRTOinterrupt);
+	TESTINT(due, DMAC_VIF1,		vif1Interrupt);
+	TESTINT(due, DMAC_GIF,		gifInterrupt);
+	TESTINT(due, DMAC_SIF0,		EEsif0Interrupt);
+	TESTINT(due, DMAC_SIF1,		EEsif1Interrupt);
 
-		TESTINT(DMAC_MFIFO_VIF, vifMFIFOInterrupt);
-		TESTINT(DMAC_MFIFO_GIF, gifMFIFOInterrupt);
+	TESTINT(due, DMAC_VIF0,		vif0Interrupt);
 
-		TESTINT(VIF_VU0_FINISH, vif0VUFinish);
-		TESTINT(VIF_VU1_FINISH, vif1VUFinish);
-	}
+	TESTINT(due, DMAC_FROM_IPU,	ipu0Interrupt);
+	TESTINT(due, DMAC_TO_IPU,	ipu1Interrupt);
+
+	TESTINT(due, DMAC_FROM_SPR,	SPRFROMinterrupt);
+	TESTINT(due, DMAC_TO_SPR,	SPRTOinterrupt);
+
+	TESTINT(due, DMAC_MFIFO_VIF, vifMFIFOInterrupt);
+	TESTINT(due, DMAC_MFIFO_GIF, gifMFIFOInterrupt);
+
+	TESTINT(due, VIF_VU0_FINISH, vif0VUFinish);
+	TESTINT(due, VIF_VU1_FINISH, vif1VUFinish);
+
+	// The callbacks may have queued or postponed events after cpuGetDueInts scheduled the
+	// next test, so schedule it again on the nearest one.
+	if( !eeEventQueue.IsEmpty() )
+		cpuSetNextEvent( cpuRegs.cycle, (s32)(eeEventQueue.TopDeadline() - cpuRegs.cycle) );
 }
 
 static __fi void _cpuTestTIMR()
@@ -363,10 +423,18 @@ static bool cpuIntsEnabled(int Interrupt)
 // if cpuRegs.cycle is greater than this cycle, should check cpuEventTest for updates
 u32 g_nextEventCycle = 0;
 
+// Threaded IOP: the longest the EE runs on (in EE cycles) before joining the IOP's
+// timeslice.  Small enough that SIF handshakes don't stall on the EE, large enough that
+// both threads get real work done in between.
+static const s32 iopThreadMaxSkew = 2048;
+
 // Shared portion of the branch test, called from both the Interpreter
 // and the recompiler.  (moved here to help alleviate redundant code)
 __fi void _cpuEventTest_Shared()
 {
+	// Threaded IOP: everything below expects an idle IOP, collect the last timeslice.
+	iopThreadJoin();
+
 	ScopedBool etest(eeEventTestIsActive);
 	g_nextEventCycle = cpuRegs.cycle + eeWaitCycles;
 
@@ -417,12 +485,18 @@ __fi void _cpuEventTest_Shared()
 
 	iopEventTest();
 
+	// PS1 mode keeps the IOP inline, see the Threaded IOP notes in R3000A.cpp
+	bool iopLaunch = false;
+
 	if( iopEventAction )
 	{
 		//if( EEsCycle < -450 )
 		//	Console.WriteLn( " IOP ahead by: %d cycles", -EEsCycle );
 
-		EEsCycle = psxCpu->ExecuteBlock( EEsCycle );
+		if( THREAD_IOP && !(psxHu32(HW_ICFG) & (1 << 3)) )
+			iopLaunch = true;
+		else
+			EEsCycle = psxCpu->ExecuteBlock( EEsCycle );
 
 		iopEventAction = false;
 	}
@@ -438,7 +512,14 @@ __fi void _cpuEventTest_Shared()
 
 	// ---- Schedule Next Event Test --------------
 
-	if( EEsCycle > 192 )
+	if( iopLaunch )
+	{
+		// The slice runs alongside the EE from here on; come back within the skew window
+		// to collect it.  (EEsCycle still holds the whole slice, so the rapid event below
+		// doesn't apply.)
+		cpuSetNextEventDelta( iopThreadMaxSkew );
+	}
+	else if( EEsCycle > 192 )
 	{
 		// EE's running way ahead of the IOP still, so we should branch quickly to give the
 		// IOP extra timeslices in short order.
@@ -456,6 +537,9 @@ __fi void _cpuEventTest_Shared()
 
 	// Apply vsync and other counter nextCycles
 	cpuSetNextEvent( nextsCounter, nextCounter );
+
+	// Last, nothing above may touch IOP state once the slice is in flight.
+	if( iopLaunch ) iopThreadLaunch( EEsCycle );
 }
 
 __ri void cpuTestINTCInts()
@@ -467,7 +551,7 @@ __ri void cpuTestINTCInts()
 	if( (psHu32(INTC_STAT) & psHu32(INTC_MASK)) == 0 ) return;
 
 	cpuSetNextEventDelta( 4 );
-	if(eeEventTestIsActive && (iopCycleEE > 0))
+	if((eeEventTestIsActive || iopThreadIsCurrent()) && (iopCycleEE > 0))
 	{
 		iopBreak += iopCycleEE;		// record the number of cycles the IOP didn't run.
 		iopCycleEE = 0;
@@ -484,7 +568,7 @@ __fi void cpuTestDMACInts()
 		 ( (psHu16(0xe010) & 0x8000) == 0) ) return;
 
 	cpuSetNextEventDelta( 4 );
-	if(eeEventTestIsActive && (iopCycleEE > 0))
+	if((eeEventTestIsActive || iopThreadIsCurrent()) && (iopCycleEE > 0))
 	{
 		iopBreak += iopCycleEE;		// record the number of cycles the IOP didn't run.
 		iopCycleEE = 0;
@@ -515,9 +599,12 @@ __fi void CPU_INT( EE_EventType n, s32 ecycle)
 	cpuRegs.sCycle[n] = cpuRegs.cycle;
 	cpuRegs.eCycle[n] = ecycle;
 
+	if( eeQueuedEvents & (1 << n) )
+		eeEventQueue.Schedule( n, cpuRegs.sCycle[n] + cpuRegs.eCycle[n] );
+
 	// Interrupt is happening soon: make sure both EE and IOP are aware.
 
-	if( ecycle <= 28 && iopCycleEE > 0 )
+	if( ecycle <= 28 && iopCycleEE > 0 && !iopThreadBusy() )
 	{
 		// If running in the IOP, force it to break immediately into the EE.
 		// the EE's branch test is due to run.
@@ -778,7 +865,7 @@ int isBreakpointNeeded(u32 addr)
 
 int isMemcheckNeeded(u32 pc)
 {
-	if (CBreakPoints::GetNumMemchecks() == 0)
+	if (CBreakPoints::GetNumInlineMemchecks() == 0)
 		return 0;
 	
 	u32 addr = pc;
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include "EventQueue.h"
+
 class BaseR5900Exception;
 
 // --------------------------------------------------------------------------------------
@@ -258,6 +260,7 @@ extern __aligned16 fpuRegisters fpuRegs;
 extern __aligned16 tlbs tlb[48];
 
 extern u32 g_nextEventCycle;
+extern EventQueue eeEventQueue;
 extern bool eeEventTestIsActive;
 extern u32 s_iLastCOP0Cycle;
 extern u32 s_iLastPERFCycle[2];
@@ -27,6 +27,7 @@
 
 #include "Elfheader.h"
 #include "Counters.h"
+#include "System/SysThreads.h"
 
 #include "Utilities/SafeArray.inl"
 #include "SPU2/spu2.h"
@@ -46,6 +47,13 @@ static void PostLoadPrep()
 	for(int i=0; i<48; i++) MapTLB(i);
 	if (EmuConfig.Gamefixes.GoemonTlbHack) GoemonPreloadTlb();
 
+	// The event queues are rebuilt from the loaded interrupt bits on the next event test.
+	eeEventQueue.Reset();
+	iopEventQueue.Reset();
+
+	// Drops the memcheck hits caused by loading the ram and re-arms their pages.
+	mmap_UpdateMemchecks();
+
 	UpdateVSyncRate();
 }
 
@@ -322,3 +330,240 @@ void memLoadingState::FreezeMem( void* data, int size )
 	m_idx += size;
 	memcpy( data, src, size );
 }
+
+// --------------------------------------------------------------------------------------
+//  memDeltaStateRing  (implementations)
+// --------------------------------------------------------------------------------------
+const uint memDeltaStateRing::PageSize;
+
+memDeltaStateRing::memDeltaStateRing( uint capacity, uint keyInterval, size_t budget )
+	: m_scratch( L"DeltaState Scratch" )
+{
+	pxAssertDev( capacity != 0, "Delta state ring must hold at least one snapshot." );
+
+	m_capacity		= capacity;
+	m_budget		= budget;
+	m_keyInterval	= std::max( keyInterval, 1u );
+	m_sinceKey		= 0;
+
+	memzero( m_stats );
+}
+
+void memDeltaStateRing::Clear()
+{
+	m_ring.clear();
+	m_key.reset();
+	m_sinceKey = 0;
+
+	m_stats.DeltaBytes	= 0;
+	m_stats.KeyBytes	= 0;
+}
+
+void memDeltaStateRing::NewKey( uint size )
+{
+	m_key = std::make_shared<memDeltaKeyState>();
+	m_key->Buffer.ExactAlloc( size );
+	memcpy( m_key->Buffer.GetPtr(), m_scratch.GetPtr(), size );
+	m_key->Size = size;
+
+	m_sinceKey = 0;
+	++m_stats.KeyCaptures;
+}
+
+// Key snapshots are shared by consecutive entries of the ring, so each distinct key is
+// only counted once.
+size_t memDeltaStateRing::GetHeldKeyBytes() const
+{
+	size_t total = 0;
+	const memDeltaKeyState* last = NULL;
+
+	for (const memDeltaSnapshot& snap : m_ring)
+	{
+		if (snap.Key.get() == last) continue;
+		last = snap.Key.get();
+		total += last->Size;
+	}
+	return total;
+}
+
+void memDeltaStateRing::EnforceLimits()
+{
+	while (m_ring.size() > 1)
+	{
+		const bool overCount	= m_ring.size() > m_capacity;
+		const bool overBudget	= m_budget && (m_stats.DeltaBytes + m_stats.KeyBytes > m_budget);
+		if (!overCount && !overBudget) break;
+
+		m_stats.DeltaBytes -= m_ring.front().GetDeltaBytes();
+		m_ring.pop_front();
+		m_stats.KeyBytes = GetHeldKeyBytes();
+	}
+}
+
+// --------------------------------------------------------------------------------------
+//  memDeltaSavingState
+// --------------------------------------------------------------------------------------
+// Saves the VM as a delta against a key snapshot.  Page-aligned blocks that the key
+// covers are compared straight from VM memory, and only their differing pages are copied
+// into the snapshot; they are flagged in 'direct' and their part of the scratch stream is
+// left stale.  Everything else goes to the scratch stream as with memSavingState.
+//
+class memDeltaSavingState : public memSavingState
+{
+	typedef memSavingState _parent;
+
+protected:
+	const memDeltaKeyState&	m_key;
+	memDeltaSnapshot&		m_snap;
+	std::vector<bool>&		m_direct;
+	u64&					m_compared;
+
+public:
+	memDeltaSavingState( VmStateBuffer& scratch, const memDeltaKeyState& key, memDeltaSnapshot& snap, std::vector<bool>& direct, u64& compared )
+		: _parent( scratch )
+		, m_key( key )
+		, m_snap( snap )
+		, m_direct( direct )
+		, m_compared( compared )
+	{
+		m_direct.assign( (m_key.Size + memDeltaStateRing::PageSize - 1) / memDeltaStateRing::PageSize, false );
+	}
+
+	void FreezeMem( void* data, int size )
+	{
+		const uint PageSize = memDeltaStateRing::PageSize;
+
+		if (!size || (m_idx % PageSize) || (size % PageSize) || ((uint)(m_idx + size) > m_key.Size))
+		{
+			_parent::FreezeMem( data, size );
+			return;
+		}
+
+		const u8* src = (const u8*)data;
+		const u8* key = m_key.Buffer.GetPtr( m_idx );
+
+		for (int offset = 0; offset < size; offset += PageSize)
+		{
+			const uint page = (m_idx + offset) / PageSize;
+			m_direct[page] = true;
+			++m_compared;
+
+			if (memcmp( src + offset, key + offset, PageSize ) == 0) continue;
+
+			m_snap.Pages.push_back( page );
+			m_snap.Data.insert( m_snap.Data.end(), src + offset, src + offset + PageSize );
+		}
+		m_idx += size;
+	}
+};
+
+// Serializes the current VM state and appends it to the ring, either as a delta against
+// the current key snapshot or as a new key.
+void memDeltaStateRing::Capture()
+{
+	pxAssertDev( GetCoreThread().IsSelf(), "Delta states must be captured from the core thread." );
+
+	++m_stats.Captures;
+
+	memDeltaSnapshot snap;
+
+	if (!m_key || (m_sinceKey >= m_keyInterval))
+	{
+		memSavingState saveme( m_scratch );
+		saveme.FreezeAll();
+		NewKey( saveme.GetCurrentPos() );
+
+		snap.Key	= m_key;
+		snap.Size	= m_key->Size;
+		++m_sinceKey;
+	}
+	else
+	{
+		memDeltaSavingState saveme( m_scratch, *m_key, snap, m_direct, m_stats.PagesCompared );
+		saveme.FreezeAll();
+
+		const uint size = saveme.GetCurrentPos();
+		snap.Key	= m_key;
+		snap.Size	= size;
+
+		const u8* cur = m_scratch.GetPtr();
+		const u8* key = m_key->Buffer.GetPtr();
+		const uint keysize = m_key->Size;
+
+		for (uint offset = 0; offset < size; offset += PageSize)
+		{
+			const uint page = offset / PageSize;
+			if ((page < m_direct.size()) && m_direct[page]) continue;
+
+			const uint len = std::min( PageSize, size - offset );
+			++m_stats.PagesCompared;
+
+			if ((offset + len <= keysize) && (memcmp( cur + offset, key + offset, len ) == 0))
+				continue;
+
+			snap.Pages.push_back( page );
+			snap.Data.insert( snap.Data.end(), cur + offset, cur + offset + len );
+		}
+
+		m_stats.PagesStored += snap.Pages.size();
+
+		// Too much of the VM has changed; a fresh key is cheaper to hold and to restore.
+		// The delta is still complete, so the key is taken on the next capture.
+		if (snap.Data.size() > keysize / 2)
+			m_sinceKey = m_keyInterval;
+		else
+			++m_sinceKey;
+	}
+
+	m_stats.DeltaBytes += snap.GetDeltaBytes();
+	m_ring.push_back( std::move(snap) );
+	m_stats.KeyBytes = GetHeldKeyBytes();
+
+	EnforceLimits();
+}
+
+// Reconstructs the full serialized stream of a snapshot.  stepsBack is relative to the
+// newest snapshot (0 = most recent).  Returns false if the ring does not reach that far.
+bool memDeltaStateRing::RestoreInto( uint stepsBack, VmStateBuffer& dest ) const
+{
+	if (stepsBack >= m_ring.size()) return false;
+
+	const memDeltaSnapshot& snap = m_ring[m_ring.size() - 1 - stepsBack];
+	const memDeltaKeyState& key = *snap.Key;
+
+	dest.MakeRoomFor( snap.Size );
+	memcpy( dest.GetPtr(), key.Buffer.GetPtr(), std::min( snap.Size, key.Size ) );
+
+	const u8* src = snap.Data.data();
+	for (u32 page : snap.Pages)
+	{
+		const uint offset = page * PageSize;
+		const uint len = std::min( PageSize, snap.Size - offset );
+
+		memcpy( dest.GetPtr(offset), src, len );
+		src += len;
+	}
+	return true;
+}
+
+// Loads a snapshot back into the VM and discards every snapshot newer than it, so that
+// subsequent captures continue from the restored point in time.
+bool memDeltaStateRing::Restore( uint stepsBack )
+{
+	if (!pxAssertDev( GetCoreThread().IsPaused(), "CoreThread is not paused; delta state cannot be restored." ))
+		return false;
+
+	if (!RestoreInto( stepsBack, m_scratch )) return false;
+
+	memLoadingState loadme( m_scratch );
+	loadme.FreezeAll();
+
+	for (uint i = 0; i < stepsBack; ++i)
+	{
+		m_stats.DeltaBytes -= m_ring.back().GetDeltaBytes();
+		m_ring.pop_back();
+	}
+	m_stats.KeyBytes = GetHeldKeyBytes();
+
+	return true;
+}
@@ -18,6 +18,8 @@
 #include "PS2Edefs.h"
 #include "System.h"
 
+#include <deque>
+
 // Savestate Versioning!
 //  If you make changes to the savestate version, please increment the value below.
 //  If the change is minor and compatibility with old states is retained, increment
@@ -201,3 +203,91 @@ public:
 	bool IsFinished() const { return m_idx >= m_memory->GetSizeInBytes(); }
 };
 
+
+// --------------------------------------------------------------------------------------
+//  memDeltaSnapshot / memDeltaStateRing
+// --------------------------------------------------------------------------------------
+// Incremental (delta) memory states, used by SysCoreThread's rewind buffer.
+//
+// A key snapshot is a full memSavingState stream.  Every other capture is taken with a
+// saver that compares each page of the stream against the key as it is produced and keeps
+// only the pages that differ.  Page-aligned blocks (EE/IOP RAM, scratchpad, hardware
+// registers and VU memory) are compared straight from VM memory and never copied whole;
+// the remaining (mostly plugin) data is written to a scratch stream and diffed afterward.
+//
+// A new key snapshot is taken every KeyInterval captures, or after a delta that grew
+// larger than half of the key (at which point the delta stops paying for itself).
+//
+// Threading: Capture() must be called from the core thread at a point where the VM can be
+// serialized (ie, at vsync).  Restore() must be called with the core thread paused, the
+// same as SysCoreThread::UploadStateCopy.
+//
+struct memDeltaKeyState
+{
+	VmStateBuffer	Buffer;
+	uint			Size;
+
+	memDeltaKeyState() : Buffer( L"DeltaState KeySnapshot" ), Size( 0 ) {}
+};
+
+struct memDeltaSnapshot
+{
+	std::shared_ptr<const memDeltaKeyState> Key;
+
+	uint				Size;		// size of the complete serialized stream, in bytes
+	std::vector<u32>	Pages;		// indices of the pages which differ from Key
+	std::vector<u8>		Data;		// packed contents of the pages listed in Pages
+
+	// Approximate host memory held by this snapshot (excludes the shared key).
+	size_t GetDeltaBytes() const { return Data.size() + Pages.size() * sizeof(u32); }
+};
+
+class memDeltaStateRing
+{
+	DeclareNoncopyableObject( memDeltaStateRing );
+
+public:
+	static const uint PageSize = __pagesize;
+
+	struct Stats
+	{
+		u64		Captures;
+		u64		KeyCaptures;
+		u64		PagesCompared;
+		u64		PagesStored;
+		u64		DeltaBytes;		// bytes currently held by deltas in the ring
+		u64		KeyBytes;		// bytes currently held by key snapshots in the ring
+	};
+
+protected:
+	std::deque<memDeltaSnapshot>	m_ring;
+	VmStateBuffer					m_scratch;
+	std::vector<bool>				m_direct;	// pages of the last capture diffed directly from VM memory
+
+	std::shared_ptr<memDeltaKeyState>	m_key;
+	uint	m_sinceKey;
+
+	uint	m_capacity;			// max number of snapshots held
+	size_t	m_budget;			// max number of bytes held by deltas and keys (0 = unbounded)
+	uint	m_keyInterval;
+
+	Stats	m_stats;
+
+public:
+	memDeltaStateRing( uint capacity, uint keyInterval = 60, size_t budget = 0 );
+	virtual ~memDeltaStateRing() = default;
+
+	void Capture();
+	bool Restore( uint stepsBack );
+	bool RestoreInto( uint stepsBack, VmStateBuffer& dest ) const;
+	void Clear();
+
+	uint GetCount() const { return m_ring.size(); }
+	uint GetCapacity() const { return m_capacity; }
+	const Stats& GetStats() const { return m_stats; }
+
+protected:
+	void NewKey( uint size );
+	void EnforceLimits();
+	size_t GetHeldKeyBytes() const;
+};
@@ -20,10 +20,40 @@
 #include "IopCommon.h"
 #include "Sif.h"
 
+sifStats sif0stats, sif1stats;
+
 void sifReset()
 {
 	memzero(sif0);
 	memzero(sif1);
+	memzero(sif0stats);
+	memzero(sif1stats);
+}
+
+static void sifPrintChannelStats(const char* name, const sifStats& stats)
+{
+	u64 count = 0;
+	for (uint i = 0; i < ArraySize(stats.blocks); i++) count += stats.blocks[i];
+	if (!count) return;
+
+	Console.WriteLn("%s: %llu blocks, %llu words, %.1f%% copied directly", name,
+		(unsigned long long)count, (unsigned long long)stats.words,
+		stats.words ? stats.direct * 100.0 / stats.words : 0.0);
+
+	for (uint i = 0; i < ArraySize(stats.blocks); i++)
+	{
+		if (!stats.blocks[i]) continue;
+		Console.WriteLn("    < %7u words  %6.2f%%  %llu", 1u << i,
+			stats.blocks[i] * 100.0 / count, (unsigned long long)stats.blocks[i]);
+	}
+}
+
+void sifPrintStats()
+{
+	if (!EmuConfig.Profiler.Enabled) return;
+
+	sifPrintChannelStats("SIF0 (iop to ee)", sif0stats);
+	sifPrintChannelStats("SIF1 (ee to iop)", sif1stats);
 }
 
 void SaveStateBase::sifFreeze()
@@ -145,7 +145,27 @@ struct _sif
 
 extern _sif sif0, sif1, sif2;
 
+// Transfer statistics of a SIF channel, reported along with the profiler.  Kept out of
+// _sif so they stay out of savestates.
+struct sifStats
+{
+	u64 blocks[21];		// iop chain blocks by size, bucket n counts sizes in [2^(n-1), 2^n) words
+	u64 words;			// words in those blocks
+	u64 direct;			// words copied straight between ee and iop ram, bypassing the fifo
+
+	void addBlock(u32 size)
+	{
+		uint bucket = 0;
+		while (size >> bucket) bucket++;
+		blocks[bucket]++;
+		words += size;
+	}
+};
+
+extern sifStats sif0stats, sif1stats;
+
 extern void sifReset();
+extern void sifPrintStats();
 
 extern void SIF0Dma();
 extern void SIF1Dma();
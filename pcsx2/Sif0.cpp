@@ -92,6 +92,37 @@ static __fi bool WriteIOPtoFifo()
 	return true;
 }
 
+// Copy whole fifo loads straight from iop to ee ram while both sides are in the middle
+// of a block.  Going through the fifo they'd take one loop each in SIF0Dma, with the fifo
+// empty at the start of every loop, so the cycle counts come out the same.  The last load
+// is left to the fifo, which leaves it in the same state as without this.
+static __fi void CopyIOPtoEE()
+{
+	if (!sif0.iop.busy || !sif0.ee.busy || !sif0ch.chcr.STR || sif0.fifo.size) return;
+
+	const int words = (std::min(sif0.iop.counter, (s32)sif0ch.qwc << 2) & ~(FIFO_SIF_W - 1)) - FIFO_SIF_W;
+	if (words <= 0) return;
+
+	// Both sides have to be plain ram
+	if ((hw_dma9.madr & 0x1fffff) + (words << 2) > Ps2MemSize::IopRam) return;
+
+	u8* dest = (u8*)dmaGetAddr(sif0ch.madr, true);
+	if (dest < eeMem->Main || dest + (words << 2) > eeMem->Main + Ps2MemSize::MainRam) return;
+
+	SIF_LOG("Copy IOP to EE: ========== %lX of %lX", words, sif0.iop.counter);
+
+	memcpy(dest, iopPhysMem(hw_dma9.madr), words << 2);
+	sif0stats.direct += words;
+
+	hw_dma9.madr += words << 2;
+	sif0.iop.cycles += words;
+	sif0.iop.counter -= words;
+
+	sif0ch.madr += words << 2;
+	sif0.ee.cycles += words >> 2;
+	sif0ch.qwc -= words >> 2;
+}
+
 // Read Fifo into an ee tag, transfer it to sif0ch, and process it.
 static __fi bool ProcessEETag()
 {
@@ -150,6 +181,7 @@ static __fi bool ProcessIOPTag()
 	if (sif0words > 0xFFFFF) DevCon.Warning("SIF0 Overrun %x", sif0words);
 	//Maximum transfer amount 1mb-16 also masking out top part which is a "Mode" cache stuff, we don't care :)
 	sif0.iop.counter = sif0words & 0xFFFFF;
+	sif0stats.addBlock(sif0.iop.counter);
 
 	sif0.iop.writeJunk = (sif0.iop.counter & 0x3) ? (4 - sif0.iop.counter & 0x3) : 0;
 	// IOP tags have an IRQ bit and an End of Transfer bit:
@@ -313,6 +345,8 @@ __fi void SIF0Dma()
 		//I realise this is very hacky in a way but its an easy way of checking if both are doing something
 		BusyCheck = 0;
 
+		CopyIOPtoEE();
+
 		if (sif0.iop.busy)
 		{
 			if(sif0.fifo.sif_free() > 0 || (sif0.iop.end && sif0.iop.counter == 0))
@@ -348,6 +382,8 @@ __fi void  EEsif0Interrupt()
 
 __fi void dmaSIF0()
 {
+	iopThreadJoin();
+
 	SIF_LOG(wxString(L"dmaSIF0" + sif0ch.cmqt_to_str()).To8BitData());
 
 	if (sif0.fifo.readPos != sif0.fifo.writePos)
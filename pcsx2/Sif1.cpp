@@ -79,6 +79,39 @@ static __fi bool WriteFifoToIOP()
 	return true;
 }
 
+// Copy whole fifo loads straight from ee to iop ram while both sides are in the middle
+// of a block, see CopyIOPtoEE in Sif0.cpp.  Not done under stall control, which checks
+// every fifo load against STADR.
+static __fi void CopyEEtoIOP()
+{
+	if (!sif1.ee.busy || !sif1.iop.busy || sif1_dma_stall || !sif1ch.chcr.STR || sif1.fifo.size) return;
+	if (dmacRegs.ctrl.STD == STD_SIF1) return;
+
+	const int words = (std::min((s32)sif1ch.qwc << 2, sif1.iop.counter) & ~(FIFO_SIF_W - 1)) - FIFO_SIF_W;
+	if (words <= 0) return;
+
+	// Both sides have to be plain ram
+	if ((hw_dma10.madr & 0x1fffff) + (words << 2) > Ps2MemSize::IopRam) return;
+
+	const u8* src = (u8*)dmaGetAddr(sif1ch.madr, false);
+	if (src < eeMem->Main || src + (words << 2) > eeMem->Main + Ps2MemSize::MainRam) return;
+
+	SIF_LOG("Sif 1: Copy EE to IOP %04X to %08X", words, HW_DMA10_MADR);
+
+	memcpy(iopPhysMem(hw_dma10.madr), src, words << 2);
+	psxCpu->Clear(hw_dma10.madr, words);
+	sif1stats.direct += words;
+
+	sif1ch.madr += words << 2;
+	hwDmacSrcTadrInc(sif1ch);
+	sif1.ee.cycles += words >> 2;
+	sif1ch.qwc -= words >> 2;
+
+	hw_dma10.madr += words << 2;
+	sif1.iop.cycles += words >> 2;
+	sif1.iop.counter -= words;
+}
+
 // Get a tag and process it.
 static __fi bool ProcessEETag()
 {
@@ -130,6 +163,7 @@ static __fi bool SIFIOPReadTag()
 	if (sif1words > 0xFFFFC) DevCon.Warning("SIF1 Overrun %x", sif1words);
 	//Maximum transfer amount 1mb-16 also masking out top part which is a "Mode" cache stuff, we don't care :)
 	sif1.iop.counter = sif1words & 0xFFFFC;
+	sif1stats.addBlock(sif1.iop.counter);
 
 	if (sif1tag.IRQ  || (sif1tag.ID & 4)) sif1.iop.end = true;
 
@@ -290,6 +324,8 @@ __fi void SIF1Dma()
 		//I realise this is very hacky in a way but its an easy way of checking if both are doing something
 		BusyCheck = 0;
 
+		CopyEEtoIOP();
+
 		if (sif1.ee.busy && !sif1_dma_stall)
 		{
 			if(sif1.fifo.sif_free() > 0 || (sif1.ee.end && sif1ch.qwc == 0))
@@ -329,6 +365,8 @@ __fi void  EEsif1Interrupt()
 // Main difference is this checks for iop, where psxDma10 checks for ee.
 __fi void dmaSIF1()
 {
+	iopThreadJoin();
+
 	SIF_LOG(wxString(L"dmaSIF1" + sif1ch.cmqt_to_str()).To8BitData());
 
 	if (sif1.fifo.readPos != sif1.fifo.writePos)
@@ -22,12 +22,14 @@
 #endif
 #include "IopBios.h"
 #include "R5900.h"
+#include "R3000A.h"
 
 #include "Counters.h"
 #include "GS.h"
 #include "Elfheader.h"
 #include "Patch.h"
 #include "SysThreads.h"
+#include "SaveState.h"
 #include "MTVU.h"
 #include "IPC.h"
 #include "FW.h"
@@ -60,6 +62,8 @@ SysCoreThread::SysCoreThread()
 	m_resetVirtualMachine = true;
 
 	m_hasActiveMachine = false;
+	m_rewindCounter = 0;
+	m_rewindAtNewest = false;
 }
 
 SysCoreThread::~SysCoreThread()
@@ -179,6 +183,31 @@ void SysCoreThread::UploadStateCopy(const VmStateBuffer& copy)
 	memLoadingState loadme(copy);
 	loadme.FreezeAll();
 	m_resetVirtualMachine = false;
+
+	// Snapshots from before the upload aren't part of this timeline.
+	if (m_rewind)
+		m_rewind->Clear();
+	m_rewindAtNewest = false;
+}
+
+// Loads a rewind snapshot and drops every snapshot newer than it.  stepsBack=0 is the
+// newest snapshot taken before the current point, so repeated Rewind(0) calls keep going
+// further back.  Returns false if rewind is off or the ring does not reach that far.
+bool SysCoreThread::Rewind(uint stepsBack)
+{
+	if (!pxAssertDev(IsPaused(), "CoreThread is not paused; cannot rewind the VM state."))
+		return false;
+
+	if (m_rewindAtNewest)
+		++stepsBack;
+
+	if (!m_rewind || !m_rewind->Restore(stepsBack))
+		return false;
+
+	m_resetVirtualMachine = false;
+	m_rewindCounter = 1;
+	m_rewindAtNewest = true;
+	return true;
 }
 
 // --------------------------------------------------------------------------------------
@@ -216,6 +245,10 @@ void SysCoreThread::_reset_stuff_as_needed()
 		m_resetVsyncTimers = false;
 
 		ForgetLoadedPatches();
+
+		if (m_rewind)
+			m_rewind->Clear();
+		m_rewindAtNewest = false;
 	}
 
 	if (m_resetVsyncTimers)
@@ -233,6 +266,33 @@ void SysCoreThread::DoCpuReset()
 	cpuReset();
 }
 
+// Takes a rewind snapshot every RewindInterval vsyncs, (re)creating or dropping the ring
+// when the rewind settings change.
+void SysCoreThread::_capture_rewind_state()
+{
+	if (!EmuConfig.EnableRewind)
+	{
+		m_rewind = nullptr;
+		m_rewindAtNewest = false;
+		return;
+	}
+
+	const uint capacity = std::max(EmuConfig.RewindSnapshots, 1u);
+	if (!m_rewind || (m_rewind->GetCapacity() != capacity))
+	{
+		m_rewind = std::make_unique<memDeltaStateRing>(capacity);
+		m_rewindCounter = 0;
+		m_rewindAtNewest = false;
+	}
+
+	if (m_rewindCounter++ % std::max(EmuConfig.RewindInterval, 1u))
+		return;
+
+	ScopedHostRamRead hostRead;
+	m_rewind->Capture();
+	m_rewindAtNewest = false;
+}
+
 // This is called from the PS2 VM at the start of every vsync (either 59.94 or 50 hz by PS2
 // clock scale, which does not correlate to the actual host machine vsync).
 //
@@ -245,6 +305,14 @@ void SysCoreThread::DoCpuReset()
 void SysCoreThread::VsyncInThread()
 {
 	ApplyLoadedPatches(PPT_CONTINUOUSLY);
+	_capture_rewind_state();
+#ifndef __LIBRETRO__
+	if (m_IpcState == ON)
+	{
+		ScopedHostRamRead hostRead;
+		m_socketIpc->VsyncInThread();
+	}
+#endif
 }
 
 void SysCoreThread::GameStartingInThread()
@@ -274,6 +342,8 @@ void SysCoreThread::GameStartingInThread()
 
 bool SysCoreThread::StateCheckInThread()
 {
+	// The IOP thread may still be running a timeslice (and using the plugins)
+	iopThreadJoin();
 	GetMTGS().RethrowException();
 	return _parent::StateCheckInThread() && (_reset_stuff_as_needed(), true);
 }
@@ -334,6 +404,7 @@ void SysCoreThread::OnCleanupInThread()
 	m_hasActiveMachine = false;
 	m_resetVirtualMachine = true;
 
+	iopThreadShutdown();
 	R3000A::ioman::reset();
 	// FIXME: temporary workaround for deadlock on exit, which actually should be a crash
 	vu1Thread.WaitVU();
@@ -26,6 +26,8 @@ using namespace Threading;
 
 typedef SafeArray<u8> VmStateBuffer;
 
+class memDeltaStateRing;
+
 // --------------------------------------------------------------------------------------
 //  SysThreadBase
 // --------------------------------------------------------------------------------------
@@ -335,6 +337,12 @@ protected:
 
 	SSE_MXCSR		m_mxcsr_saved;
 
+	// Delta savestates captured every EmuConfig.RewindInterval vsyncs while EnableRewind
+	// is set.  Only touched by the core thread, or by other threads while it is paused.
+	std::unique_ptr<memDeltaStateRing> m_rewind;
+	uint			m_rewindCounter;
+	bool			m_rewindAtNewest;	// VM sits at the newest snapshot (rewound, nothing captured since)
+
 public:
 	explicit SysCoreThread();
 	virtual ~SysCoreThread();
@@ -353,6 +361,7 @@ public:
 
 	virtual void ApplySettings( const Pcsx2Config& src );
 	virtual void UploadStateCopy( const VmStateBuffer& copy );
+	virtual bool Rewind( uint stepsBack );
 
 	virtual bool HasActiveMachine() const { return m_hasActiveMachine; }
 
@@ -361,6 +370,7 @@ public:
 
 protected:
 	void _reset_stuff_as_needed();
+	void _capture_rewind_state();
 
 	virtual void Start();
 	virtual void OnStart();
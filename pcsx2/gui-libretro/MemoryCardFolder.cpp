@@ -42,6 +42,8 @@ void FolderMemoryCard::InitializeInternalData() {
 	memset( &m_fat, 0xFF, sizeof( m_fat ) );
 	memset( &m_backupBlock1, 0xFF, sizeof( m_backupBlock1 ) );
 	memset( &m_backupBlock2, 0xFF, sizeof( m_backupBlock2 ) );
+	m_writeback.WaitForIdle();
+	m_pendingPages.clear();
 	m_cache.clear();
 	m_oldDataCache.clear();
 	m_lastAccessedFile.CloseAll();
@@ -113,6 +115,16 @@ void FolderMemoryCard::Close( bool flush ) {
 		Flush();
 	}
 
+	// make sure everything is on disk before anyone else gets to look at the folder
+	m_writeback.WaitForIdle();
+	m_pendingPages.clear();
+
+	const FolderMemoryCardWriteback::Stats stats = GetWritebackStats();
+	if ( stats.flushes > 0 ) {
+		Console.WriteLn( L"(FolderMcd) Slot %u: %u background flushes wrote %u bytes to %u files in %u ms.",
+			m_slot, (uint)stats.flushes, (uint)stats.bytesWritten, (uint)stats.filesWritten, (uint)stats.totalFlushMs );
+	}
+
 	m_cache.clear();
 	m_oldDataCache.clear();
 	m_lastAccessedFile.CloseAll();
@@ -726,6 +738,24 @@ bool FolderMemoryCard::ReadFromFile( u8 *dest, u32 adr, u32 dataLength ) {
 	auto it = m_fileMetadataQuickAccess.find( fatCluster );
 	if ( it != m_fileMetadataQuickAccess.end() ) {
 		const u32 clusterNumber = it->second.consecutiveCluster;
+
+		// data of the last flushes may still be on its way to the file, serve it from memory until it's there
+		PrunePendingPages();
+		if ( !m_pendingPages.empty() ) {
+			auto pending = m_pendingPages.find( page );
+			if ( pending != m_pendingPages.end() ) {
+				memcpy( dest, &pending->second.data.raw[offset], dataLength );
+				return true;
+			}
+
+			// don't create a file the writeback is about to create, its unwritten parts are blank anyway
+			wxFileName fn( m_folderName );
+			it->second.GetPath( &fn );
+			if ( !fn.FileExists() ) {
+				return false;
+			}
+		}
+
 		wxFFile* file = m_lastAccessedFile.ReOpen( m_folderName, &it->second );
 		if ( file->IsOpened() ) {
 			const u32 clusterOffset = ( page % 2 ) * PageSize + offset;
@@ -852,7 +882,28 @@ s32 FolderMemoryCard::Save( const u8 *src, u32 adr, int size ) {
 	return 1;
 }
 
+void FolderMemoryCard::PrunePendingPages() {
+	if ( m_pendingPages.empty() ) { return; }
+
+	const u64 completed = m_writeback.GetCompleted();
+	bool pruned = false;
+	for ( auto it = m_pendingPages.begin(); it != m_pendingPages.end(); ) {
+		if ( it->second.job <= completed ) {
+			it = m_pendingPages.erase( it );
+			pruned = true;
+		} else {
+			++it;
+		}
+	}
+
+	// read handles may have buffered the file contents from before the writeback got to them
+	if ( pruned ) {
+		m_lastAccessedFile.CloseAll();
+	}
+}
+
 void FolderMemoryCard::NextFrame() {
+	PrunePendingPages();
 	if ( m_framesUntilFlush > 0 && --m_framesUntilFlush == 0 ) {
 		Flush();
 	}
@@ -868,6 +919,33 @@ void FolderMemoryCard::Flush() {
 	Console.WriteLn( L"(FolderMcd) Writing data for slot %u to file system...", m_slot );
 	const u64 timeFlushStart = wxGetLocalTimeMillis().GetValue();
 
+	// Files are written by the writeback thread from now on, so don't keep stale read handles around.
+	m_lastAccessedFile.CloseAll();
+	if ( !m_writebackJob ) {
+		m_writebackJob = std::make_unique<FolderMemoryCardWritebackJob>();
+	}
+
+	FlushCache();
+
+	if ( !m_writebackJob->IsEmpty() ) {
+		const u64 job = m_writeback.Submit( std::move( m_writebackJob ) );
+		for ( const auto& flushed : m_flushedPages ) {
+			m_pendingPages[flushed.first] = PendingPage{ flushed.second, job };
+		}
+	}
+	m_writebackJob.reset();
+	m_flushedPages.clear();
+
+	const u64 timeFlushEnd = wxGetLocalTimeMillis().GetValue();
+	Console.WriteLn( L"(FolderMcd) Done! Took %u ms, file system writes continue in the background.", timeFlushEnd - timeFlushStart );
+
+	#ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
+	m_writeback.WaitForIdle();
+	WriteToFile( m_folderName.GetFullPath().RemoveLast() + L"-debug_" + wxDateTime::Now().Format( L"%Y-%m-%d-%H-%M-%S" ) + L"_post-flush.ps2" );
+	#endif
+}
+
+void FolderMemoryCard::FlushCache() {
 	// Keep a copy of the old file entries so we can figure out which files and directories, if any, have been deleted from the memory card.
 	std::vector<MemoryCardFileEntryTreeNode> oldFileEntryTree;
 	if ( IsFormatted() ) {
@@ -918,22 +996,14 @@ void FolderMemoryCard::Flush() {
 		FlushPage( i );
 	}
 
-	m_lastAccessedFile.FlushAll();
-	m_lastAccessedFile.ClearMetadataWriteState();
 	m_oldDataCache.clear();
-
-	const u64 timeFlushEnd = wxGetLocalTimeMillis().GetValue();
-	Console.WriteLn( L"(FolderMcd) Done! Took %u ms.", timeFlushEnd - timeFlushStart );
-
-	#ifdef DEBUG_WRITE_FOLDER_CARD_IN_MEMORY_TO_FILE_ON_CHANGE
-	WriteToFile( m_folderName.GetFullPath().RemoveLast() + L"-debug_" + wxDateTime::Now().Format( L"%Y-%m-%d-%H-%M-%S" ) + L"_post-flush.ps2" );
-	#endif
 }
 
 bool FolderMemoryCard::FlushPage( const u32 page ) {
 	auto it = m_cache.find( page );
 	if ( it != m_cache.end() ) {
 		WriteWithoutCache( &it->second.raw[0], page * PageSizeRaw, PageSize );
+		m_flushedPages[page] = it->second;
 		m_cache.erase( it );
 		return true;
 	}
@@ -960,10 +1030,7 @@ bool FolderMemoryCard::FlushBlock( const u32 block ) {
 void FolderMemoryCard::FlushSuperBlock() {
 	if ( FlushBlock( 0 ) && m_performFileWrites ) {
 		wxFileName superBlockFileName( m_folderName.GetPath(), L"_pcsx2_superblock" );
-		wxFFile superBlockFile( superBlockFileName.GetFullPath().c_str(), L"wb" );
-		if ( superBlockFile.IsOpened() ) {
-			superBlockFile.Write( &m_superBlock.raw, sizeof( m_superBlock.raw ) );
-		}
+		m_writebackJob->AddWriteFile( superBlockFileName.GetFullPath(), &m_superBlock.raw, sizeof( m_superBlock.raw ) );
 	}
 }
 
@@ -996,21 +1063,12 @@ void FolderMemoryCard::FlushFileEntries( const u32 dirCluster, const u32 remaini
 
 				if ( m_performFileWrites ) {
 					// if this directory has nonstandard metadata, write that to the file system
-					wxFileName metaFileName( m_folderName.GetFullPath() + subDirPath + L"/_pcsx2_meta_directory" );
+					const wxString metaFileName( m_folderName.GetFullPath() + subDirPath + L"/_pcsx2_meta_directory" );
 					if ( filenameCleaned || entry->entry.data.mode != MemoryCardFileEntry::DefaultDirMode || entry->entry.data.attr != 0 ) {
-						if ( !metaFileName.DirExists() ) {
-							metaFileName.Mkdir();
-						}
-						wxFFile metaFile( metaFileName.GetFullPath(), L"wb" );
-						if ( metaFile.IsOpened() ) {
-							metaFile.Write( entry->entry.raw, sizeof( entry->entry.raw ) );
-							metaFile.Close();
-						}
+						m_writebackJob->AddWriteFile( metaFileName, entry->entry.raw, sizeof( entry->entry.raw ) );
 					} else {
 						// if metadata is standard make sure to remove a possibly existing metadata file
-						if ( metaFileName.FileExists() ) {
-							wxRemoveFile( metaFileName.GetFullPath() );
-						}
+						m_writebackJob->AddOperation( FolderMemoryCardWritebackJob::Operation::Op_RemoveFile, metaFileName );
 					}
 				}
 
@@ -1028,14 +1086,7 @@ void FolderMemoryCard::FlushFileEntries( const u32 dirCluster, const u32 remaini
 				const wxString filePath = dirPath + L"/" + wxString::FromAscii( (const char*)cleanName );
 
 				if ( m_performFileWrites ) {
-					wxFileName fn( m_folderName.GetFullPath() + filePath );
-					if ( !fn.FileExists() ) {
-						if ( !fn.DirExists() ) {
-							fn.Mkdir( 0777, wxPATH_MKDIR_FULL );
-						}
-						wxFFile createEmptyFile( fn.GetFullPath(), L"wb" );
-						createEmptyFile.Close();
-					}
+					m_writebackJob->AddOperation( FolderMemoryCardWritebackJob::Operation::Op_CreateEmptyFile, m_folderName.GetFullPath() + filePath );
 				}
 			}
 		}
@@ -1071,11 +1122,7 @@ void FolderMemoryCard::FlushDeletedFilesAndRemoveUnchangedDataFromCache( const s
 				const wxString filePath = m_folderName.GetFullPath() + dirPath + L"/" + fileName;
 				m_lastAccessedFile.CloseMatching( filePath );
 				const wxString newFilePath = m_folderName.GetFullPath() + dirPath + L"/_pcsx2_deleted_" + fileName;
-				if ( wxFileName::DirExists( newFilePath ) ) {
-					// wxRenameFile doesn't overwrite directories, so we have to remove the old one first
-					RemoveDirectory( newFilePath );
-				}
-				wxRenameFile( filePath, newFilePath );
+				m_writebackJob->AddOperation( FolderMemoryCardWritebackJob::Operation::Op_RenameDeleted, filePath, newFilePath );
 			} else if ( entry->IsDir() ) {
 				// still exists and is a directory, recursive call for subdir
 				char cleanName[sizeof( entry->entry.data.name )];
@@ -1176,34 +1223,29 @@ bool FolderMemoryCard::WriteToFile( const u8* src, u32 adr, u32 dataLength ) {
 		const u32 clusterNumber = it->second.consecutiveCluster;
 		
 		if ( m_performFileWrites ) {
-			wxFFile* file = m_lastAccessedFile.ReOpen( m_folderName, &it->second, true );
-			if ( file->IsOpened() ) {
-				const u32 clusterOffset = ( page % 2 ) * PageSize + offset;
-				const u32 fileSize = entry->entry.data.length;
-				const u32 fileOffsetStart = std::min( clusterNumber * ClusterSize + clusterOffset, fileSize );
-				const u32 fileOffsetEnd = std::min( fileOffsetStart + dataLength, fileSize );
-				const u32 bytesToWrite = fileOffsetEnd - fileOffsetStart;
-
-				wxFileOffset actualFileSize = file->Length();
-				if ( actualFileSize < fileOffsetStart ) {
-					file->Seek( actualFileSize );
-					const u32 diff = fileOffsetStart - actualFileSize;
-					u8 temp = 0xFF;
-					for ( u32 i = 0; i < diff; ++i ) {
-						file->Write( &temp, 1 );
-					}
-				}
+			if ( !m_writebackJob ) {
+				m_writebackJob = std::make_unique<FolderMemoryCardWritebackJob>();
+			}
 
-				const wxFileOffset fileOffset = file->Tell();
-				if ( fileOffset != fileOffsetStart ) {
-					file->Seek( fileOffsetStart );
-				}
-				if ( bytesToWrite > 0 ) {
-					file->Write( src, bytesToWrite );
-				}
-			} else {
-				return false;
+			wxFileName fn( m_folderName );
+			const bool cleanedFilename = it->second.GetPath( &fn );
+			const wxString filePath( fn.GetFullPath() );
+
+			// the first write to a file in this flush also takes care of its metadata
+			auto fileWrite = m_writebackJob->files.find( filePath );
+			if ( fileWrite == m_writebackJob->files.end() ) {
+				QueueFileMetadata( fn, cleanedFilename, entry );
+				fileWrite = m_writebackJob->files.emplace( filePath, FolderMemoryCardWritebackJob::FileWrite() ).first;
 			}
+
+			const u32 clusterOffset = ( page % 2 ) * PageSize + offset;
+			const u32 fileSize = entry->entry.data.length;
+			const u32 fileOffsetStart = std::min( clusterNumber * ClusterSize + clusterOffset, fileSize );
+			const u32 fileOffsetEnd = std::min( fileOffsetStart + dataLength, fileSize );
+
+			fileWrite->second.timeCreated = entry->entry.data.timeCreated;
+			fileWrite->second.timeModified = entry->entry.data.timeModified;
+			fileWrite->second.Add( fileOffsetStart, src, fileOffsetEnd - fileOffsetStart );
 		}
 
 		return true;
@@ -1212,6 +1254,18 @@ bool FolderMemoryCard::WriteToFile( const u8* src, u32 adr, u32 dataLength ) {
 	return false;
 }
 
+void FolderMemoryCard::QueueFileMetadata( const wxFileName& fileName, const bool cleanedFilename, const MemoryCardFileEntry* const entry ) {
+	wxFileName metadataFilename( fileName );
+	metadataFilename.AppendDir( L"_pcsx2_meta" );
+
+	const bool metadataIsNonstandard = cleanedFilename || entry->entry.data.mode != MemoryCardFileEntry::DefaultFileMode || entry->entry.data.attr != 0;
+	if ( metadataIsNonstandard ) {
+		m_writebackJob->AddWriteFile( metadataFilename.GetFullPath(), entry->entry.raw, sizeof( entry->entry.raw ) );
+	} else {
+		m_writebackJob->AddOperation( FolderMemoryCardWritebackJob::Operation::Op_RemoveMetadataFile, metadataFilename.GetFullPath() );
+	}
+}
+
 void FolderMemoryCard::CopyEntryDictIntoTree( std::vector<MemoryCardFileEntryTreeNode>* fileEntryTree, const u32 cluster, const u32 fileCount ) {
 	const MemoryCardFileEntryCluster* entryCluster = &m_fileEntryDict[cluster];
 	u32 fileCluster = cluster;
@@ -1281,6 +1335,7 @@ u64 FolderMemoryCard::GetCRC() const {
 }
 
 void FolderMemoryCard::SetSlot( uint slot ) {
+	m_writeback.SetSlot( slot );
 	pxAssert( slot < 8 );
 	m_slot = slot;
 }
@@ -1387,6 +1442,235 @@ void FolderMemoryCard::WriteToFile( const wxString& filename ) {
 }
 
 
+void FolderMemoryCardWritebackJob::FileWrite::Add( u32 offset, const u8* src, u32 length ) {
+	// extend the range ending at or containing offset if there is one, otherwise start a new range
+	auto it = ranges.upper_bound( offset );
+	if ( it != ranges.begin() && std::prev( it )->first + std::prev( it )->second.size() >= offset ) {
+		--it;
+	} else {
+		it = ranges.emplace( offset, std::vector<u8>() ).first;
+	}
+
+	std::vector<u8>& data = it->second;
+	const u32 start = offset - it->first;
+	if ( data.size() < start + length ) {
+		data.resize( start + length );
+	}
+	memcpy( data.data() + start, src, length );
+
+	// merge with following ranges we now touch
+	auto next = std::next( it );
+	while ( next != ranges.end() && next->first <= it->first + data.size() ) {
+		const u32 nextStart = next->first - it->first;
+		if ( data.size() < nextStart + next->second.size() ) {
+			data.resize( nextStart + next->second.size() );
+		}
+		// data we just wrote takes precedence over what was there before
+		for ( u32 i = 0; i < next->second.size(); ++i ) {
+			if ( nextStart + i < start || nextStart + i >= start + length ) {
+				data[nextStart + i] = next->second[i];
+			}
+		}
+		next = ranges.erase( next );
+	}
+}
+
+void FolderMemoryCardWritebackJob::AddOperation( Operation::OperationType type, const wxString& path, const wxString& target ) {
+	Operation op;
+	op.type = type;
+	op.path = path;
+	op.target = target;
+	operations.push_back( std::move( op ) );
+}
+
+void FolderMemoryCardWritebackJob::AddWriteFile( const wxString& path, const void* data, size_t length ) {
+	Operation op;
+	op.type = Operation::Op_WriteFile;
+	op.path = path;
+	op.data.assign( (const u8*)data, (const u8*)data + length );
+	operations.push_back( std::move( op ) );
+}
+
+FolderMemoryCardWriteback::~FolderMemoryCardWriteback() {
+	if ( m_thread.joinable() ) {
+		{
+			std::lock_guard<std::mutex> lock( m_mutex );
+			m_quit = true;
+		}
+		m_workAvailable.notify_one();
+		m_thread.join();
+	}
+}
+
+u64 FolderMemoryCardWriteback::Submit( std::unique_ptr<FolderMemoryCardWritebackJob> job ) {
+	u64 number;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex );
+		if ( !m_thread.joinable() ) {
+			m_thread = std::thread( &FolderMemoryCardWriteback::ThreadMain, this );
+		}
+		m_queue.push_back( std::move( job ) );
+		number = ++m_submitted;
+	}
+	m_workAvailable.notify_one();
+	return number;
+}
+
+bool FolderMemoryCardWriteback::IsIdle() {
+	std::lock_guard<std::mutex> lock( m_mutex );
+	return m_queue.empty() && !m_busy;
+}
+
+void FolderMemoryCardWriteback::WaitForIdle() {
+	std::unique_lock<std::mutex> lock( m_mutex );
+	m_idle.wait( lock, [this] { return m_queue.empty() && !m_busy; } );
+}
+
+FolderMemoryCardWriteback::Stats FolderMemoryCardWriteback::GetStats() {
+	std::lock_guard<std::mutex> lock( m_mutex );
+	return m_stats;
+}
+
+void FolderMemoryCardWriteback::ThreadMain() {
+	std::unique_lock<std::mutex> lock( m_mutex );
+	while ( true ) {
+		m_workAvailable.wait( lock, [this] { return m_quit || !m_queue.empty(); } );
+		// always drain the queue before quitting, these are the user's saves
+		if ( m_queue.empty() ) {
+			break;
+		}
+
+		std::unique_ptr<FolderMemoryCardWritebackJob> job = std::move( m_queue.front() );
+		m_queue.pop_front();
+		m_busy = true;
+		lock.unlock();
+
+		Execute( *job );
+		m_completed.fetch_add( 1, std::memory_order_release );
+
+		lock.lock();
+		m_busy = false;
+		if ( m_queue.empty() ) {
+			m_idle.notify_all();
+		}
+	}
+}
+
+void FolderMemoryCardWriteback::Execute( const FolderMemoryCardWritebackJob& job ) {
+	typedef FolderMemoryCardWritebackJob::Operation Operation;
+	const u64 timeStart = wxGetLocalTimeMillis().GetValue();
+
+	for ( const Operation& op : job.operations ) {
+		switch ( op.type ) {
+			case Operation::Op_WriteFile: {
+				wxFileName fn( op.path );
+				if ( !fn.DirExists() ) {
+					fn.Mkdir( 0777, wxPATH_MKDIR_FULL );
+				}
+				wxFFile file( op.path, L"wb" );
+				if ( file.IsOpened() ) {
+					file.Write( op.data.data(), op.data.size() );
+				}
+				break;
+			}
+			case Operation::Op_RemoveFile:
+			case Operation::Op_RemoveMetadataFile: {
+				if ( wxFileName::FileExists( op.path ) ) {
+					wxRemoveFile( op.path );
+
+					// and remove the metadata dir if it's now empty
+					if ( op.type == Operation::Op_RemoveMetadataFile ) {
+						wxFileName fn( op.path );
+						wxDir metaDir( fn.GetPath() );
+						if ( metaDir.IsOpened() && !metaDir.HasFiles() ) {
+							wxRmdir( fn.GetPath() );
+						}
+					}
+				}
+				break;
+			}
+			case Operation::Op_CreateEmptyFile: {
+				wxFileName fn( op.path );
+				if ( !fn.FileExists() ) {
+					if ( !fn.DirExists() ) {
+						fn.Mkdir( 0777, wxPATH_MKDIR_FULL );
+					}
+					wxFFile createEmptyFile( op.path, L"wb" );
+					createEmptyFile.Close();
+				}
+				break;
+			}
+			case Operation::Op_RenameDeleted: {
+				if ( wxFileName::DirExists( op.target ) ) {
+					// wxRenameFile doesn't overwrite directories, so we have to remove the old one first
+					RemoveDirectory( op.target );
+				}
+				wxRenameFile( op.path, op.target );
+				break;
+			}
+		}
+	}
+
+	u64 bytesWritten = 0;
+	for ( const auto& file : job.files ) {
+		bytesWritten += ExecuteFileWrite( file.first, file.second );
+	}
+
+	const u64 timeEnd = wxGetLocalTimeMillis().GetValue();
+
+	std::lock_guard<std::mutex> lock( m_mutex );
+	m_stats.flushes++;
+	m_stats.bytesWritten += bytesWritten;
+	m_stats.filesWritten += job.files.size();
+	m_stats.lastFlushMs = timeEnd - timeStart;
+	m_stats.totalFlushMs += timeEnd - timeStart;
+
+	Console.WriteLn( L"(FolderMcd) Slot %u: wrote %u bytes to %u files in %u ms.", m_slot, (uint)bytesWritten, (uint)job.files.size(), (uint)( timeEnd - timeStart ) );
+}
+
+u64 FolderMemoryCardWriteback::ExecuteFileWrite( const wxString& path, const FolderMemoryCardWritebackJob::FileWrite& write ) {
+	wxFileName fn( path );
+	if ( !fn.FileExists() ) {
+		if ( !fn.DirExists() ) {
+			fn.Mkdir( 0777, wxPATH_MKDIR_FULL );
+		}
+		wxFFile createEmptyFile( path, L"wb" );
+		createEmptyFile.Close();
+	}
+
+	wxFFile file( path, L"r+b" );
+	if ( !file.IsOpened() ) {
+		return 0;
+	}
+
+	u64 bytesWritten = 0;
+	for ( const auto& range : write.ranges ) {
+		const u32 offset = range.first;
+
+		// pad the file with 0xFF if it's shorter than where we want to write
+		const wxFileOffset actualFileSize = file.Length();
+		if ( actualFileSize < offset ) {
+			const std::vector<u8> padding( offset - actualFileSize, 0xFF );
+			file.Seek( actualFileSize );
+			file.Write( padding.data(), padding.size() );
+		}
+
+		if ( !range.second.empty() ) {
+			file.Seek( offset );
+			file.Write( range.second.data(), range.second.size() );
+			bytesWritten += range.second.size();
+		}
+	}
+
+	file.Close();
+
+	wxDateTime modified = write.timeModified.ToWxDateTime();
+	wxDateTime created = write.timeCreated.ToWxDateTime();
+	fn.SetTimes( nullptr, &modified, &created );
+
+	return bytesWritten;
+}
+
 FileAccessHelper::FileAccessHelper() {
 	m_files.clear();
 	m_lastWrittenFileRef = nullptr;
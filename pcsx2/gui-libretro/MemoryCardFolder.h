@@ -20,6 +20,11 @@
 #include <wx/ffile.h>
 #include <map>
 #include <vector>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "PluginCallbacks.h"
 #include "AppConfig.h"
@@ -250,6 +255,102 @@ protected:
 	void WriteMetadata( bool metadataIsNonstandard, wxFileName& metadataFilename, const MemoryCardFileEntry* const entry );
 };
 
+// --------------------------------------------------------------------------------------
+//  FolderMemoryCardWritebackJob
+// --------------------------------------------------------------------------------------
+// All host file system operations resulting from a single flush of a FolderMemoryCard.
+// Everything in here is fully resolved (paths, data, timestamps), so the job can be
+// executed without touching the memory card's internal state.
+struct FolderMemoryCardWritebackJob {
+	struct Operation {
+		enum OperationType {
+			Op_WriteFile,              // (re)write path with data
+			Op_RemoveFile,             // remove path if it exists
+			Op_RemoveMetadataFile,     // remove path if it exists, and its directory if it's now empty
+			Op_CreateEmptyFile,        // create path (and its directory) if it doesn't exist
+			Op_RenameDeleted,          // rename path to target, replacing target if it's a directory
+		};
+
+		OperationType type;
+		wxString path;
+		wxString target;
+		std::vector<u8> data;
+	};
+
+	// coalesced data writes to a single file, keyed by file offset
+	struct FileWrite {
+		std::map<u32, std::vector<u8>> ranges;
+		MemoryCardFileEntryDateTime timeCreated;
+		MemoryCardFileEntryDateTime timeModified;
+
+		void Add( u32 offset, const u8* src, u32 length );
+	};
+
+	// executed in order, before any of the data writes
+	std::vector<Operation> operations;
+	std::map<wxString, FileWrite> files;
+
+	void AddOperation( Operation::OperationType type, const wxString& path, const wxString& target = L"" );
+	void AddWriteFile( const wxString& path, const void* data, size_t length );
+
+	bool IsEmpty() const { return operations.empty() && files.empty(); }
+};
+
+// --------------------------------------------------------------------------------------
+//  FolderMemoryCardWriteback
+// --------------------------------------------------------------------------------------
+// Executes FolderMemoryCardWritebackJobs on a background thread, so that the emulation
+// thread doesn't wait on the host file system when a memory card is flushed.
+class FolderMemoryCardWriteback {
+public:
+	struct Stats {
+		u64 flushes;          // jobs completed
+		u64 bytesWritten;     // file data bytes written
+		u64 filesWritten;     // data files opened for writing
+		u64 lastFlushMs;      // time spent executing the last job
+		u64 totalFlushMs;     // time spent executing all jobs
+	};
+
+protected:
+	std::thread m_thread;
+	std::mutex m_mutex;
+	std::condition_variable m_workAvailable;
+	std::condition_variable m_idle;
+	std::deque<std::unique_ptr<FolderMemoryCardWritebackJob>> m_queue;
+	bool m_busy = false;
+	bool m_quit = false;
+
+	Stats m_stats = {};
+	uint m_slot = 0;
+
+	// jobs are numbered from 1 in submission order and executed in that order
+	u64 m_submitted = 0;
+	std::atomic<u64> m_completed{ 0 };
+
+public:
+	FolderMemoryCardWriteback() = default;
+	~FolderMemoryCardWriteback();
+
+	void SetSlot( uint slot ) { m_slot = slot; }
+
+	// queues a job, starting the writeback thread if necessary, and returns its number
+	u64 Submit( std::unique_ptr<FolderMemoryCardWritebackJob> job );
+
+	// number of the last job that has been executed completely
+	u64 GetCompleted() const { return m_completed.load( std::memory_order_acquire ); }
+
+	// blocks until all submitted jobs have been executed
+	void WaitForIdle();
+	bool IsIdle();
+
+	Stats GetStats();
+
+protected:
+	void ThreadMain();
+	void Execute( const FolderMemoryCardWritebackJob& job );
+	u64 ExecuteFileWrite( const wxString& path, const FolderMemoryCardWritebackJob::FileWrite& write );
+};
+
 // --------------------------------------------------------------------------------------
 //  FolderMemoryCard
 // --------------------------------------------------------------------------------------
@@ -314,8 +415,24 @@ protected:
 	u64 m_timeLastWritten;
 
 	// remembers and keeps the last accessed file open for further access
+	// only used for reading, writes go through m_writeback
 	FileAccessHelper m_lastAccessedFile;
 
+	// performs the host file system writes of a flush in the background
+	FolderMemoryCardWriteback m_writeback;
+	// file system operations of the flush currently in progress, nullptr outside of Flush()
+	std::unique_ptr<FolderMemoryCardWritebackJob> m_writebackJob;
+	// pages flushed by the flush currently in progress, moved to m_pendingPages when its job is submitted
+	std::map<u32, MemoryCardPage> m_flushedPages;
+
+	// pages whose data is still on its way to the file system, with the number of the job writing them
+	// file data is read from here until the writeback has executed that job, so reads never wait for it
+	struct PendingPage {
+		MemoryCardPage data;
+		u64 job;
+	};
+	std::map<u32, PendingPage> m_pendingPages;
+
 	// path to the folder that contains the files of this memory card
 	wxFileName m_folderName;
 
@@ -375,6 +492,8 @@ public:
 
 	void WriteToFile( const wxString& filename );
 
+	FolderMemoryCardWriteback::Stats GetWritebackStats() { return m_writeback.GetStats(); }
+
 protected:
 	// initializes memory card data, as if it was fresh from the factory
 	void InitializeInternalData();
@@ -479,12 +598,22 @@ protected:
 
 
 	bool ReadFromFile( u8 *dest, u32 adr, u32 dataLength );
+
+	// drops the pending pages of writeback jobs that have completed
+	void PrunePendingPages();
 	bool WriteToFile( const u8* src, u32 adr, u32 dataLength );
 
 
 	// flush the whole cache to the internal data and/or host file system
+	// host file system writes are queued to m_writeback and happen asynchronously
 	void Flush();
 
+	// worker of Flush(), fills m_writebackJob
+	void FlushCache();
+
+	// queues metadata of a file for writing, see FileAccessHelper::WriteMetadata()
+	void QueueFileMetadata( const wxFileName& fileName, const bool cleanedFilename, const MemoryCardFileEntry* const entry );
+
 	// flush a single page of the cache to the internal data and/or host file system
 	bool FlushPage( const u32 page );
 
@@ -17,6 +17,8 @@
 #include "App.h"
 #include "AppGameDatabase.h"
 #include <wx/stdpaths.h>
+#include <wx/ffile.h>
+#include <wx/mstream.h>
 
 class DBLoaderHelper
 {
@@ -158,23 +160,51 @@ AppGameDatabase& AppGameDatabase::LoadFromFile(const wxString& _file, const wxSt
 		return *this;
 	}
 
-	wxFFileInputStream reader( file );
+	// The whole database is read in one go; it's both parsed and hashed from memory.
+	wxFFile dbfile( file, L"rb" );
+	SafeArray<u8> dbdata;
+	bool readOk = dbfile.IsOpened();
 
-	if (!reader.IsOk())
+	if (readOk)
+	{
+		dbdata.ExactAlloc((int)dbfile.Length());
+		readOk = dbfile.Read(dbdata.GetPtr(), dbdata.GetSizeInBytes()) == (size_t)dbdata.GetSizeInBytes();
+	}
+
+	if (!readOk)
 	{
 		//throw Exception::FileNotFound( file );
 		Console.Error(L"(GameDB) Could not access file (permission denied?) [%s]", WX_STR(file));
+		return *this;
 	}
 
-	DBLoaderHelper loader( reader, *this );
-
 	u64 qpc_Start = GetCPUTicks();
+
+	// The binary index is keyed on the hash of the text database, so any edit to the
+	// database (or a new release) just causes it to be rebuilt on the next startup.
+	const u64 dbhash = GameDatabaseIndex::HashSource(dbdata.GetPtr(), dbdata.GetSizeInBytes());
+	const wxString indexfile( GetSettingsFolder().Combine(wxFileName(L"GameIndex.idx")).GetFullPath() );
+
+	if (m_index.Open(indexfile, dbhash))
+	{
+		u64 qpc_end = GetCPUTicks();
+		Console.WriteLn( "(GameDB) %u games on record (loaded from index in %ums)",
+			m_index.GetGameCount(), (u32)(((qpc_end-qpc_Start)*1000) / GetTickFrequency()) );
+		return *this;
+	}
+
+	wxMemoryInputStream reader( dbdata.GetPtr(), dbdata.GetSizeInBytes() );
+	DBLoaderHelper loader( reader, *this );
 	loader.ReadGames();
+
 	u64 qpc_end = GetCPUTicks();
 
 	Console.WriteLn( "(GameDB) %d games on record (loaded in %ums)",
 		gHash.size(), (u32)(((qpc_end-qpc_Start)*1000) / GetTickFrequency()) );
 
+	if (!GameDatabaseIndex::Write(indexfile, dbhash, gHash))
+		Console.Warning(L"(GameDB) Could not write database index [%s]", WX_STR(indexfile));
+
 	return *this;
 }
 
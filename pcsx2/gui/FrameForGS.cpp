@@ -51,6 +51,7 @@ void GSPanel::InitDefaultAccelerators()
 	if (!m_Accels) m_Accels = std::unique_ptr<AcceleratorDictionary>(new AcceleratorDictionary);
 
 	m_Accels->Map( AAC( WXK_F1 ),				"States_FreezeCurrentSlot" );
+	m_Accels->Map( AAC( WXK_F1 ).Shift(),		"States_Rewind" );
 	m_Accels->Map( AAC( WXK_F3 ),				"States_DefrostCurrentSlot");
 	m_Accels->Map( AAC( WXK_F3 ).Shift(),		"States_DefrostCurrentSlotBackup");
 	m_Accels->Map( AAC( WXK_F2 ),				"States_CycleSlotForward" );
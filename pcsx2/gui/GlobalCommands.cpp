@@ -162,6 +162,20 @@ namespace Implementations
 		pauser.AllowResume();
 	}
 
+	void States_Rewind()
+	{
+		if (!g_Conf->EmuOptions.EnableRewind)
+			return;
+
+		ScopedCoreThreadPause pauser;
+		if (CoreThread.Rewind(0))
+			OSDlog(Color_StrongBlue, true, "(Rewind) Restored an earlier state.");
+		else
+			OSDlog(Color_StrongRed, true, "(Rewind) No earlier state to restore.");
+
+		pauser.AllowResume();
+	}
+
 	void Framelimiter_MasterToggle()
 	{
 		ScopedCoreThreadPause pauser;
@@ -685,6 +699,14 @@ static const GlobalCommandDescriptor CommandDeclarations[] =
 			false,
 		},
 
+		{
+			"States_Rewind",
+			Implementations::States_Rewind,
+			pxL("Rewind"),
+			pxL("Restores the most recent rewind snapshot (Rewind must be enabled in the ini)."),
+			false,
+		},
+
 		{
 			"States_CycleSlotForward",
 			States_CycleSlotForward,
@@ -350,6 +350,8 @@ __fi void SIF2Dma()
 
 __fi void  sif2Interrupt()
 {
+	iopThreadSyncEE();
+
 	if (!sif2.iop.end || sif2.iop.counter > 0)
 	{
 		SIF2Dma();
@@ -369,6 +371,8 @@ __fi void  EEsif2Interrupt()
 
 __fi void dmaSIF2()
 {
+	iopThreadJoin();
+
 	DevCon.Warning("SIF2 EE CHCR %x", sif2dma.chcr._u32);
 	SIF_LOG(wxString(L"dmaSIF2" + sif2dma.cmqt_to_str()).To8BitData());
 
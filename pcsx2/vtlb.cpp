@@ -308,6 +308,77 @@ void __fastcall vtlb_memWrite128(u32 mem, const mem128_t *value)
 	}
 }
 
+// Copies a block of guest virtual memory.  Pages mapped to host memory are copied
+// directly; anything else (hardware registers, unmapped pages) is handled one byte at
+// a time through the regular handlers.  Note that the EE data cache is bypassed, same
+// as with the recompilers.
+void vtlb_memReadBlock(u32 addr, void* dest, u32 size)
+{
+	u8* dst = (u8*)dest;
+
+	while (size)
+	{
+		const u32 len = std::min(size, VTLB_PAGE_SIZE - (addr & VTLB_PAGE_MASK));
+		auto vmv = vtlbdata.vmap[addr>>VTLB_PAGE_BITS];
+
+		if (!vmv.isHandler(addr))
+			memcpy(dst, (u8*)vmv.assumePtr(addr), len);
+		else
+			for (u32 i = 0; i < len; i++)
+				dst[i] = vtlb_memRead<mem8_t>(addr + i);
+
+		addr += len;
+		dst  += len;
+		size -= len;
+	}
+}
+
+void vtlb_memWriteBlock(u32 addr, const void* source, u32 size)
+{
+	const u8* src = (const u8*)source;
+
+	while (size)
+	{
+		const u32 len = std::min(size, VTLB_PAGE_SIZE - (addr & VTLB_PAGE_MASK));
+		auto vmv = vtlbdata.vmap[addr>>VTLB_PAGE_BITS];
+
+		if (!vmv.isHandler(addr))
+			memcpy((u8*)vmv.assumePtr(addr), src, len);
+		else
+			for (u32 i = 0; i < len; i++)
+				vtlb_memWrite<mem8_t>(addr + i, src[i]);
+
+		addr += len;
+		src  += len;
+		size -= len;
+	}
+}
+
+// Returns true if every page of the block is backed by memory or by a device handler,
+// ie, a block copy won't raise a TLB miss or bus error, or hit the unmapped physical
+// handlers.  Use it to validate addresses that come from outside the VM.
+bool vtlb_IsMapped(u32 addr, u32 size)
+{
+	if (!size) return true;
+
+	const u32 last = addr + size - 1;
+	if (last < addr) return false;
+
+	for (u32 page = addr >> VTLB_PAGE_BITS; page <= (last >> VTLB_PAGE_BITS); page++)
+	{
+		const u32 vaddr = page << VTLB_PAGE_BITS;
+		auto vmv = vtlbdata.vmap[page];
+		if (!vmv.isHandler(vaddr)) continue;
+
+		const vtlbHandler handler = vmv.assumeHandlerGetID();
+		if (handler == UnmappedVirtHandler0 || handler == UnmappedVirtHandler1 ||
+			handler == UnmappedPhyHandler0 || handler == UnmappedPhyHandler1 ||
+			handler == DefaultPhyHandler)
+			return false;
+	}
+	return true;
+}
+
 template mem8_t vtlb_memRead<mem8_t>(u32 mem);
 template mem16_t vtlb_memRead<mem16_t>(u32 mem);
 template mem32_t vtlb_memRead<mem32_t>(u32 mem);
@@ -95,6 +95,11 @@ extern void __fastcall vtlb_memWrite(u32 mem, DataType value);
 extern void __fastcall vtlb_memWrite64(u32 mem, const mem64_t* value);
 extern void __fastcall vtlb_memWrite128(u32 mem, const mem128_t* value);
 
+// Bulk copies to/from virtual memory, for tools (IPC, debugger) rather than the CPUs.
+extern void vtlb_memReadBlock(u32 mem, void* dest, u32 size);
+extern void vtlb_memWriteBlock(u32 mem, const void* src, u32 size);
+extern bool vtlb_IsMapped(u32 mem, u32 size);
+
 extern void vtlb_DynGenWrite(u32 sz);
 extern void vtlb_DynGenRead32(u32 bits, bool sign);
 extern void vtlb_DynGenRead64(u32 sz);
@@ -41,6 +41,10 @@ _xmmregs xmmregs[iREGCNT_XMM], s_saveXMMregs[iREGCNT_XMM];
 // X86 caching
 _x86regs x86regs[iREGCNT_GPR], s_saveX86regs[iREGCNT_GPR];
 
+// The EE and IOP recompilers share the register caches above; when the IOP runs on its
+// own thread (THREAD_IOP) each block compile holds this lock.
+Threading::Mutex g_recCompileMutex;
+
 // XMM Caching
 #define VU_VFx_ADDR(x)  (uptr)&VU->VF[x].UL[0]
 #define VU_ACCx_ADDR    (uptr)&VU->ACC.UL[0]
@@ -114,6 +114,7 @@ struct _x86regs {
 };
 
 extern _x86regs x86regs[iREGCNT_GPR], s_saveX86regs[iREGCNT_GPR];
+extern Threading::Mutex g_recCompileMutex;
 
 uptr _x86GetAddr(int type, int reg);
 void _initX86regs();
@@ -25,6 +25,8 @@
 #include "System/RecTypes.h"
 
 #include <time.h>
+#include <map>
+#include <unordered_map>
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -216,6 +218,159 @@ static void _DynGen_Dispatchers()
 
 ////////////////////////////////////////////////////
 using namespace R3000A;
+
+// --------------------------------------------------------------------------------------
+//  Block profiler  (Profiler.RecBlocks_IOP)
+// --------------------------------------------------------------------------------------
+// Every block starts with a few instructions that count its executions and charge the host
+// cycles (rdtsc) elapsed since the previous block started to that block.  The cycles of a
+// block therefore include the memory handlers and event tests it calls.  Recompilation time
+// is excluded.  The report groups the blocks by the irx library whose export table is the
+// nearest below them, so the attribution of non-exported helpers is approximate.
+
+struct iopBlockProfile
+{
+	u32 size;		// in instructions, of the last compile
+	u64 count;
+	u64 cycles;
+};
+
+static bool s_profiling = false;
+static std::unordered_map<u32, iopBlockProfile> s_blockProfile;	// keyed on HWADDR(startpc)
+static iopBlockProfile s_profileIdle;		// dispatcher and recompiler time, not reported
+static iopBlockProfile* s_profilePrev = &s_profileIdle;
+static u64 s_profileTicks;
+
+static __fi u64 iopProfileTicks()
+{
+#ifdef _MSC_VER
+	return __rdtsc();
+#else
+	return __builtin_ia32_rdtsc();
+#endif
+}
+
+// Closes the running measurement, the time until the next block is charged to nothing.
+static void iopProfileBreak()
+{
+	const u64 now = iopProfileTicks();
+	s_profilePrev->cycles += now - s_profileTicks;
+	s_profilePrev = &s_profileIdle;
+	s_profileTicks = now;
+}
+
+static void iopProfileEmitBlock( u32 hwaddr )
+{
+	iopBlockProfile& prof = s_blockProfile[hwaddr];
+
+	// edx:eax = now - s_profileTicks
+	xRDTSC();
+	xSUB(eax, ptr32[(u32*)&s_profileTicks]);
+	xSBB(edx, ptr32[(u32*)&s_profileTicks + 1]);
+
+	xADD(ptr32[(u32*)&s_profileTicks], eax);
+	xADC(ptr32[(u32*)&s_profileTicks + 1], edx);
+
+	xMOV(rcx, ptrNative[&s_profilePrev]);
+	xADD(ptr32[rcx + (s32)offsetof(iopBlockProfile, cycles)], eax);
+	xADC(ptr32[rcx + (s32)offsetof(iopBlockProfile, cycles) + 4], edx);
+
+	xLoadFarAddr(rcx, &prof);
+	xMOV(ptrNative[&s_profilePrev], rcx);
+	xADD(ptr32[rcx + (s32)offsetof(iopBlockProfile, count)], 1);
+	xADC(ptr32[rcx + (s32)offsetof(iopBlockProfile, count) + 4], 0);
+}
+
+void recPrintIopBlockProfile()
+{
+	if( s_blockProfile.empty() ) return;
+
+	struct Entry
+	{
+		u32 hwaddr;
+		const iopBlockProfile* prof;
+		std::string module;
+		std::string label;
+	};
+
+	const std::vector<irxExport> exports( irxScanExports() );
+
+	std::vector<Entry> blocks;
+	std::map<std::string, u64> modules;
+	u64 total = 0;
+
+	for( const auto& it : s_blockProfile )
+	{
+		if( !it.second.count ) continue;
+
+		Entry e = { it.first, &it.second };
+		u32 addr = it.first & 0x1fffffff;
+		char label[64];
+
+		if( addr >= 0x1fc00000 )
+		{
+			e.module = "rom";
+			snprintf( label, sizeof(label), "rom+0x%x", addr - 0x1fc00000 );
+		}
+		else
+		{
+			addr &= Ps2MemSize::IopRam - 1;
+			auto ex = std::upper_bound( exports.begin(), exports.end(), addr,
+				[](u32 a, const irxExport& b) { return a < b.addr; } );
+
+			if( ex == exports.begin() )
+			{
+				e.module = "kernel";
+				snprintf( label, sizeof(label), "kernel+0x%x", addr );
+			}
+			else
+			{
+				--ex;
+				const char* funcname = irxImportFuncname( ex->libname, ex->index );
+				e.module = ex->libname;
+				if( funcname )
+					snprintf( label, sizeof(label), "%s:%s+0x%x", ex->libname.c_str(), funcname, addr - ex->addr );
+				else
+					snprintf( label, sizeof(label), "%s:%u+0x%x", ex->libname.c_str(), ex->index, addr - ex->addr );
+			}
+		}
+		e.label = label;
+
+		modules[e.module] += it.second.cycles;
+		total += it.second.cycles;
+		blocks.push_back( std::move(e) );
+	}
+
+	if( !total ) return;
+
+	std::sort( blocks.begin(), blocks.end(), [](const Entry& a, const Entry& b) { return a.prof->cycles > b.prof->cycles; } );
+
+	std::vector< std::pair<u64, std::string> > ranked;
+	for( const auto& m : modules )
+		ranked.push_back( std::make_pair(m.second, m.first) );
+	std::sort( ranked.rbegin(), ranked.rend() );
+
+	Console.WriteLn( "IOP block profile: %u blocks, %.1f Mticks", (u32)blocks.size(), total / 1e6 );
+
+	Console.WriteLn( "  Modules:" );
+	for( const auto& m : ranked )
+	{
+		const double pct = m.first * 100.0 / total;
+		if( pct < 0.1 ) break;
+		Console.WriteLn( "    %-10s %6.2f%%  %10.1f Mticks", m.second.c_str(), pct, m.first / 1e6 );
+	}
+
+	Console.WriteLn( "  Blocks:" );
+	for( size_t i = 0; i < blocks.size() && i < 40; ++i )
+	{
+		const Entry& e = blocks[i];
+		const double pct = e.prof->cycles * 100.0 / total;
+		if( pct < 0.1 ) break;
+		Console.WriteLn( "    %08x %6.2f%%  count=%-10llu ticks/run=%-6llu insts=%-4u %s",
+			e.hwaddr, pct, (unsigned long long)e.prof->count,
+			(unsigned long long)(e.prof->cycles / e.prof->count), e.prof->size, e.label.c_str() );
+	}
+}
 #include "Utilities/AsciiFile.h"
 
 static void iIopDumpBlock( int startpc, u8 * ptr )
@@ -686,6 +841,12 @@ void recResetIOP()
 
 	Perf::iop.reset();
 
+	// the counters are referenced by the generated code
+	recPrintIopBlockProfile();
+	s_blockProfile.clear();
+	s_profilePrev = &s_profileIdle;
+	s_profiling = EmuConfig.Profiler.Enabled && EmuConfig.Profiler.RecBlocks_IOP;
+
 	recAlloc();
 	recMem->Reset();
 
@@ -750,6 +911,9 @@ static void recShutdown()
 	safe_free( s_pInstCache );
 	s_nInstCacheSize = 0;
 
+	recPrintIopBlockProfile();
+	s_blockProfile.clear();
+
 	// FIXME Warning thread unsafe
 	Perf::dump();
 }
@@ -792,8 +956,16 @@ static __noinline s32 recExecuteBlock( s32 eeCycles )
 // 	mov         edx,dword ptr [iopCycleEE (832A84h)]
 // 	lea         eax,[edx+ecx]
 
+	if( s_profiling )
+	{
+		s_profilePrev = &s_profileIdle;
+		s_profileTicks = iopProfileTicks();
+	}
+
 	iopEnterRecompiledCode();
 
+	if( s_profiling ) iopProfileBreak();
+
 	return iopBreak + iopCycleEE;
 }
 
@@ -1083,6 +1255,8 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 	u32 i;
 	u32 willbranch3 = 0;
 
+	Threading::ScopedLock lock( THREAD_IOP ? &g_recCompileMutex : NULL );
+
 	// Inject IRX hack
 	if (startpc == 0x1630 && g_Conf->CurrentIRX.Length() > 3) {
 		if (iopMemRead32(0x20018) == 0x1F) {
@@ -1099,6 +1273,8 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 
 	pxAssert( startpc );
 
+	if( s_profiling ) iopProfileBreak();
+
 	// if recPtr reached the mem limit reset whole mem
 	if (recPtr >= (recMem->GetPtrEnd() - _64kb)) {
 		recResetIOP();
@@ -1129,6 +1305,8 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 
 	_initX86regs();
 
+	if( s_profiling ) iopProfileEmitBlock( HWADDR(startpc) );
+
 	if ((psxHu32(HW_ICFG) & 8) && (HWADDR(startpc) == 0xa0 || HWADDR(startpc) == 0xb0 || HWADDR(startpc) == 0xc0)) {
 		xFastCall((void*)psxBiosCall);
 		xTEST(al, al);
@@ -1263,6 +1441,8 @@ StartRecomp:
 	pxAssert( (psxpc-startpc)>>2 <= 0xffff );
 	s_pCurBlockEx->size = (psxpc-startpc)>>2;
 
+	if( s_profiling ) s_blockProfile[HWADDR(startpc)].size = s_pCurBlockEx->size;
+
 	for(i = 1; i < (u32)s_pCurBlockEx->size; ++i) {
 		if (s_pCurBlock[i].GetFnptr() == (uptr)iopJITCompile)
 			s_pCurBlock[i].SetFnptr((uptr)iopJITCompileInBlock);
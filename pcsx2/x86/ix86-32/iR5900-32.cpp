@@ -29,10 +29,12 @@
 
 #include "System/SysThreads.h"
 #include "GS.h"
+#include "Sif.h"
 #include "CDVD/CDVD.h"
 #include "Elfheader.h"
 
 #include "../DebugTools/Breakpoints.h"
+#include "../DebugTools/SymbolMap.h"
 #include "Patch.h"
 
 #if !PCSX2_SEH
@@ -333,8 +335,17 @@ static DynGenFunc* ExitRecompiledCode	= NULL;
 static DynGenFunc* DispatchBlockDiscard = NULL;
 static DynGenFunc* DispatchPageReset    = NULL;
 
+static void recExitExecution();
+
 static void recEventTest()
 {
+	if (mmap_TestMemchecks())
+	{
+		CBreakPoints::SetBreakpointTriggered(true);
+		GetCoreThread().PauseSelfDebug();
+		recExitExecution();
+	}
+
 	_cpuEventTest_Shared();
 }
 
@@ -591,10 +602,26 @@ static bool eeCpuExecuting = false;
 static bool g_resetEeScalingStats = false;
 static int g_patchesNeedRedo = 0;
 
+// Names the blocks in the perf jitdump after the function they belong to.
+static bool recPerfSymbol(u32 pc, char* dest, size_t size)
+{
+	u32 start = symbolMap.GetFunctionStart(pc);
+	if (start == SymbolMap::INVALID_ADDRESS)
+		return false;
+
+	std::string name = symbolMap.GetLabelString(start);
+	if (name.empty())
+		return false;
+
+	snprintf(dest, size, "%s+0x%x", name.c_str(), pc - start);
+	return true;
+}
+
 ////////////////////////////////////////////////////
 static void recResetRaw()
 {
 	Perf::ee.reset();
+	Perf::ee.set_symbols(recPerfSymbol);
 
 	EE::Profiler.Reset();
 
@@ -746,7 +773,13 @@ static void recExecute()
 	Perf::dump();
 #endif
 
+	// The last event test may have left an IOP timeslice running on the IOP thread, which
+	// adds to the block profile printed below.
+	iopThreadJoin();
+
 	EE::Profiler.Print();
+	recPrintIopBlockProfile();
+	sifPrintStats();
 }
 
 ////////////////////////////////////////////////////
@@ -1235,7 +1268,7 @@ void recMemcheck(u32 op, u32 bits, bool store)
 	auto checks = CBreakPoints::GetMemChecks();
 	for (size_t i = 0; i < checks.size(); i++)
 	{
-		if (checks[i].result == 0)
+		if (checks[i].result == 0 || checks[i].UsesPageProtection())
 			continue;
 		if ((checks[i].cond & MEMCHECK_WRITE) == 0 && store)
 			continue;
@@ -1657,6 +1690,9 @@ static void __fastcall recRecompile( const u32 startpc )
 	u32 willbranch3 = 0;
 	u32 usecop2;
 
+	ScopedLock lock( THREAD_IOP ? &g_recCompileMutex : NULL );
+	ScopedHostRamRead hostRead;		// code fetches aren't loads
+
 #ifdef PCSX2_DEBUG
     if (dumplog & 4) iDumpRegisters(startpc, 0);
 #endif
@@ -23,6 +23,7 @@
 #include "GSdx.h"
 #include "GSUtil.h"
 #include "Renderers/SW/GSRendererSW.h"
+#include "Renderers/SW/GSRasterizerBenchmark.h"
 #include "Renderers/Null/GSRendererNull.h"
 #include "Renderers/Null/GSDeviceNull.h"
 #include "Renderers/OpenGL/GSDeviceOGL.h"
@@ -950,6 +951,139 @@ EXPORT_C GSsetExclusive(int enabled)
 	}
 }
 
+// lpszCmdLine:
+//   Number of rasterizer threads to go up to (default: all cores).
+
+EXPORT_C GSBenchmarkSW(char* lpszCmdLine)
+{
+	if(GSinit() != 0)
+	{
+		fprintf(stderr, "GSinit failed\n");
+		return;
+	}
+
+	int threads = lpszCmdLine != NULL && *lpszCmdLine ? atoi(lpszCmdLine) : (int)std::thread::hardware_concurrency();
+
+	GSRasterizerBenchmark* benchmark = new GSRasterizerBenchmark();
+
+	benchmark->Run(std::max<int>(threads, 0), 1000);
+
+	delete benchmark;
+
+	GSshutdown();
+}
+
+// lpszCmdLine:
+//   Number of upload threads (default: extrathreads_upload).
+//
+// WriteImage of a full 1024x1024 transfer for every PSM, unswizzled on this thread only and then
+// with the upload workers.
+
+EXPORT_C GSBenchmarkWriteImage(char* lpszCmdLine)
+{
+	if(GSinit() != 0)
+	{
+		fprintf(stderr, "GSinit failed\n");
+		return;
+	}
+
+	GSLocalMemory* mem = new GSLocalMemory();
+
+	static struct {int psm; const char* name;} s_format[] =
+	{
+		{PSM_PSMCT32, "32"},
+		{PSM_PSMCT24, "24"},
+		{PSM_PSMCT16, "16"},
+		{PSM_PSMCT16S, "16S"},
+		{PSM_PSMT8, "8"},
+		{PSM_PSMT4, "4"},
+		{PSM_PSMT8H, "8H"},
+		{PSM_PSMT4HL, "4HL"},
+		{PSM_PSMT4HH, "4HH"},
+		{PSM_PSMZ32, "32Z"},
+		{PSM_PSMZ24, "24Z"},
+		{PSM_PSMZ16, "16Z"},
+		{PSM_PSMZ16S, "16ZS"},
+	};
+
+	int threads = lpszCmdLine != NULL && *lpszCmdLine ? atoi(lpszCmdLine) : theApp.GetConfigI("extrathreads_upload");
+
+	threads = std::max<int>(threads, 0);
+
+	uint8* ptr = (uint8*)_aligned_malloc(1024 * 1024 * 4, 32);
+
+	for(int i = 0; i < 1024 * 1024 * 4; i++) ptr[i] = (uint8)i;
+
+	const int n = 64;
+
+	const int w = 1024;
+	const int h = 1024;
+
+	printf("WriteImage %d x %d, 0 / %d extra threads\n\n", w, h, threads);
+
+	for(size_t i = 0; i < countof(s_format); i++)
+	{
+		const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[s_format[i].psm];
+
+		GSLocalMemory::writeImage wi = psm.wi;
+
+		GIFRegBITBLTBUF BITBLTBUF;
+
+		BITBLTBUF.DBP = 0;
+		BITBLTBUF.DBW = w / 64;
+		BITBLTBUF.DPSM = s_format[i].psm;
+
+		GIFRegTRXPOS TRXPOS;
+
+		TRXPOS.DSAX = 0;
+		TRXPOS.DSAY = 0;
+
+		GIFRegTRXREG TRXREG;
+
+		TRXREG.RRW = w;
+		TRXREG.RRH = h;
+
+		int trlen = w * h * psm.trbpp / 8;
+
+		printf("[%4s] ", s_format[i].name);
+
+		// without upload workers the second pass would only repeat the first
+
+		for(int mt = 0; mt < (threads > 0 ? 2 : 1); mt++)
+		{
+			mem->SetWriteThreads(mt ? threads : 0);
+
+			// wall clock, clock() would add up the time of the workers
+
+			auto start = std::chrono::steady_clock::now();
+
+			for(int j = 0; j < n; j++)
+			{
+				int x = 0;
+				int y = 0;
+
+				(mem->*wi)(x, y, ptr, trlen, BITBLTBUF, TRXPOS, TRXREG);
+			}
+
+			auto end = std::chrono::steady_clock::now();
+
+			int ms = std::max<int>((int)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), 1);
+
+			printf("%6d %6d | ", (int)((float)trlen * n / ms / 1000), (int)((float)(w * h) * n / ms / 1000));
+		}
+
+		printf("\n");
+	}
+
+	printf("\n");
+
+	_aligned_free(ptr);
+
+	delete mem;
+
+	GSshutdown();
+}
+
 #ifdef _WIN32
 
 #include <io.h>
@@ -1319,6 +1453,10 @@ EXPORT_C GSBenchmark(HWND hwnd, HINSTANCE hinst, LPSTR lpszCmdLine, int nCmdShow
 
 	//
 
+	GSBenchmarkWriteImage(NULL);
+
+	//
+
 	if(0)
 	{
 		GSLocalMemory* mem = new GSLocalMemory();
@@ -86,6 +86,13 @@ enum GIF_REG_COMPLEX
 {
 	GIF_REG_STQRGBAXYZF2	= 0x00,
 	GIF_REG_STQRGBAXYZ2		= 0x01,
+	GIF_REG_UVRGBAXYZF2		= 0x02,
+	GIF_REG_UVRGBAXYZ2		= 0x03,
+	GIF_REG_RGBAUVXYZF2		= 0x04,
+	GIF_REG_RGBAUVXYZ2		= 0x05,
+	GIF_REG_RGBAXYZF2		= 0x06,
+	GIF_REG_RGBAXYZ2		= 0x07,
+	GIF_REG_COMPLEX_COUNT
 };
 
 enum GIF_A_D_REG
@@ -1120,7 +1127,8 @@ struct alignas(32) GIFPath
 	uint32 type;
 	GSVector4i regs;
 
-	enum {TYPE_UNKNOWN, TYPE_ADONLY, TYPE_STQRGBAXYZF2, TYPE_STQRGBAXYZ2};
+	// the TYPE_STQRGBAXYZF2 and later types are in the same order as GIF_REG_COMPLEX
+	enum {TYPE_UNKNOWN, TYPE_ADONLY, TYPE_STQRGBAXYZF2, TYPE_STQRGBAXYZ2, TYPE_UVRGBAXYZF2, TYPE_UVRGBAXYZ2, TYPE_RGBAUVXYZF2, TYPE_RGBAUVXYZ2, TYPE_RGBAXYZF2, TYPE_RGBAXYZ2};
 
 	__forceinline void SetTag(const void* mem)
 	{
@@ -1157,11 +1165,17 @@ struct alignas(32) GIFPath
 				switch(nreg)
 				{
 				case 1: break;
-				case 2: break;
+				case 2:
+					if(regs.u32[0] == 0x00000401) type = TYPE_RGBAXYZF2; // untextured gouraud
+					if(regs.u32[0] == 0x00000501) type = TYPE_RGBAXYZ2;
+					break;
 				case 3:
 					if(regs.u32[0] == 0x00040102) type = TYPE_STQRGBAXYZF2; // many games, TODO: formats mixed with NOPs (xeno2: 040f010f02, 04010f020f, mgs3: 04010f0f02, 0401020f0f, 04010f020f)
 					if(regs.u32[0] == 0x00050102) type = TYPE_STQRGBAXYZ2; // GoW (has other crazy formats, like ...030503050103)
-					// TODO: common types with UV instead
+					if(regs.u32[0] == 0x00040103) type = TYPE_UVRGBAXYZF2; // same as above with UV (FST)
+					if(regs.u32[0] == 0x00050103) type = TYPE_UVRGBAXYZ2;
+					if(regs.u32[0] == 0x00040301) type = TYPE_RGBAUVXYZF2;
+					if(regs.u32[0] == 0x00050301) type = TYPE_RGBAUVXYZ2;
 					break;
 				case 4: break;
 				case 5: break;
@@ -396,6 +396,8 @@ GSCapture::GSCapture()
 	m_threads = theApp.GetConfigI("capture_threads");
 #if defined(__unix__)
 	m_compression_level = theApp.GetConfigI("png_compression_level");
+	m_format = theApp.GetConfigI("capture_format");
+	m_file = theApp.GetConfigS("capture_file");
 #endif
 }
 
@@ -520,8 +522,25 @@ std::wstring* GSCapture::BeginCapture(float fps, GSVector2i recommendedResolutio
 	m_size.x = theApp.GetConfigI("CaptureWidth");
 	m_size.y = theApp.GetConfigI("CaptureHeight");
 
-	for(int i = 0; i < m_threads; i++) {
-		m_workers.push_back(std::unique_ptr<GSPng::Worker>(new GSPng::Worker(&GSPng::Process)));
+	if (m_format == GSCaptureStream::Y4M || m_format == GSCaptureStream::RGB) {
+		// 4:2:0 conversion works on 8x2 pixel blocks
+		m_size.x = (m_size.x + 7) & ~7;
+		m_size.y = (m_size.y + 1) & ~1;
+
+		std::string target = m_file;
+		if (target.empty())
+			target = m_out_dir + (m_format == GSCaptureStream::Y4M ? "/capture.y4m" : "/capture.rgb");
+
+		m_stream = std::unique_ptr<GSCaptureStream>(new GSCaptureStream((GSCaptureStream::Format)m_format, target, m_size.x, m_size.y, fps, m_threads));
+
+		if (!m_stream->IsOpen()) {
+			m_stream = nullptr;
+			return nullptr;
+		}
+	} else {
+		for(int i = 0; i < m_threads; i++) {
+			m_workers.push_back(std::unique_ptr<GSPng::Worker>(new GSPng::Worker(&GSPng::Process)));
+		}
 	}
 
 	m_capturing = true;
@@ -551,6 +570,14 @@ bool GSCapture::DeliverFrame(const void* bits, int pitch, bool rgba)
 
 #elif defined(__unix__)
 
+	if (m_stream) {
+		m_stream->DeliverFrame(bits, pitch, rgba);
+
+		m_frame++;
+
+		return true;
+	}
+
 	std::string out_file = m_out_dir + format("/frame.%010d.png", m_frame);
 	//GSPng::Save(GSPng::RGB_PNG, out_file, (uint8*)bits, m_size.x, m_size.y, pitch, m_compression_level);
 	m_workers[m_frame%m_threads]->Push(std::make_shared<GSPng::Transaction>(GSPng::RGB_PNG, out_file, static_cast<const uint8*>(bits), m_size.x, m_size.y, pitch, m_compression_level));
@@ -584,6 +611,7 @@ bool GSCapture::EndCapture()
 
 #elif defined(__unix__)
 	m_workers.clear();
+	m_stream = nullptr;
 
 	m_frame = 0;
 
@@ -26,6 +26,8 @@
 
 #ifdef _WIN32
 #include "Window/GSCaptureDlg.h"
+#elif defined(__unix__)
+#include "GSCaptureStream.h"
 #endif
 
 class GSCapture
@@ -47,6 +49,11 @@ class GSCapture
 	std::vector<std::unique_ptr<GSPng::Worker>> m_workers;
 	int m_compression_level;
 
+	// 0: one png per frame, otherwise a GSCaptureStream::Format
+	int m_format;
+	std::string m_file;
+	std::unique_ptr<GSCaptureStream> m_stream;
+
 	#endif
 
 public:
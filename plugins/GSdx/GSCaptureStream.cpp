@@ -0,0 +1,298 @@
+/*
+ *	Copyright (C) 2007-2009 Gabest
+ *	http://www.gabest.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with GNU Make; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "stdafx.h"
+#include "GSCaptureStream.h"
+#include "GSVector.h"
+
+// BT.601 limited range, 8 pixels at a time in 16 bit lanes. All the intermediate sums
+// stay within 0..65535, so the unsigned wrap-around of add16/sub16 doesn't matter.
+
+static __forceinline void SplitRGB(const GSVector4i& p0, const GSVector4i& p1, bool rgba, GSVector4i& r, GSVector4i& g, GSVector4i& b)
+{
+	GSVector4i mask = GSVector4i::x000000ff();
+
+	GSVector4i c0 = (p0 & mask).ps32(p1 & mask);
+	GSVector4i c2 = (p0.srl32(16) & mask).ps32(p1.srl32(16) & mask);
+
+	g = (p0.srl32(8) & mask).ps32(p1.srl32(8) & mask);
+	r = rgba ? c0 : c2;
+	b = rgba ? c2 : c0;
+}
+
+static __forceinline GSVector4i Luma(const GSVector4i& r, const GSVector4i& g, const GSVector4i& b)
+{
+	GSVector4i y = r.mul16l(GSVector4i(_mm_set1_epi16(66)))
+		.add16(g.mul16l(GSVector4i(_mm_set1_epi16(129))))
+		.add16(b.mul16l(GSVector4i(_mm_set1_epi16(25))))
+		.add16(GSVector4i(_mm_set1_epi16(128)));
+
+	return y.srl16(8).add16(GSVector4i(_mm_set1_epi16(16)));
+}
+
+// Averages the 2x2 blocks of the given two rows, the 4 results are in the even 16 bit lanes.
+static __forceinline GSVector4i Average2x2(const GSVector4i& c0, const GSVector4i& c1)
+{
+	GSVector4i s = c0.add16(c1);
+
+	s = s.add16(s.srl32(16)) & GSVector4i::x0000ffff();
+
+	return s.add16(GSVector4i(_mm_set1_epi16(2))).srl16(2);
+}
+
+static void ConvertRowsToYUV(const uint8* src0, const uint8* src1, uint8* y0, uint8* y1, uint8* u, uint8* v, int w, bool rgba)
+{
+	const GSVector4i bias = GSVector4i(_mm_set1_epi16(128 * 256 + 128));
+
+	for(int x = 0; x < w; x += 8)
+	{
+		GSVector4i r0, g0, b0, r1, g1, b1;
+
+		SplitRGB(GSVector4i::load<false>(&src0[x * 4]), GSVector4i::load<false>(&src0[x * 4 + 16]), rgba, r0, g0, b0);
+		SplitRGB(GSVector4i::load<false>(&src1[x * 4]), GSVector4i::load<false>(&src1[x * 4 + 16]), rgba, r1, g1, b1);
+
+		GSVector4i::storel(&y0[x], Luma(r0, g0, b0).pu16());
+		GSVector4i::storel(&y1[x], Luma(r1, g1, b1).pu16());
+
+		GSVector4i r = Average2x2(r0, r1);
+		GSVector4i g = Average2x2(g0, g1);
+		GSVector4i b = Average2x2(b0, b1);
+
+		GSVector4i cb = bias
+			.add16(b.mul16l(GSVector4i(_mm_set1_epi16(112))))
+			.sub16(r.mul16l(GSVector4i(_mm_set1_epi16(38))))
+			.sub16(g.mul16l(GSVector4i(_mm_set1_epi16(74))));
+
+		GSVector4i cr = bias
+			.add16(r.mul16l(GSVector4i(_mm_set1_epi16(112))))
+			.sub16(g.mul16l(GSVector4i(_mm_set1_epi16(94))))
+			.sub16(b.mul16l(GSVector4i(_mm_set1_epi16(18))));
+
+		// only the even lanes hold values
+		GSVector4i mask = GSVector4i::x0000ffff();
+
+		*(uint32*)&u[x / 2] = (cb.srl16(8) & mask).ps32().pu16().extract32<0>();
+		*(uint32*)&v[x / 2] = (cr.srl16(8) & mask).ps32().pu16().extract32<0>();
+	}
+}
+
+GSCaptureStream::GSCaptureStream(Format format, const std::string& target, int w, int h, float fps, int threads)
+	: m_format(format)
+	, m_width(w)
+	, m_height(h)
+	, m_fp(NULL)
+	, m_pipe(false)
+	, m_next_in(0)
+	, m_next_out(0)
+	, m_exit(false)
+	, m_waits(0)
+{
+	ASSERT((w & 7) == 0 && (h & 1) == 0);
+
+	if(!target.empty() && target[0] == '|')
+	{
+		m_fp = popen(target.c_str() + 1, "w");
+		m_pipe = true;
+	}
+	else
+	{
+		m_fp = px_fopen(target, "wb");
+	}
+
+	if(m_fp == NULL)
+	{
+		fprintf(stderr, "GSCaptureStream: Error failed to open %s\n", target.c_str());
+		return;
+	}
+
+	if(m_format == Y4M)
+	{
+		fprintf(m_fp, "YUV4MPEG2 W%d H%d F%d:1000 Ip A1:1 C420jpeg\n", w, h, (int)(fps * 1000 + 0.5f));
+	}
+
+	threads = std::max(threads, 1);
+
+	size_t out_size = m_format == Y4M ? w * h * 3 / 2 : w * h * 3;
+
+	for(int i = 0; i < threads * 2; i++)
+	{
+		Frame* f = new Frame();
+
+		f->state = Frame::Free;
+		f->rgba = true;
+		f->in.resize(w * h * 4);
+		f->out.resize(out_size);
+
+		m_frames.push_back(std::unique_ptr<Frame>(f));
+	}
+
+	for(int i = 0; i < threads; i++)
+	{
+		m_workers.push_back(std::unique_ptr<Worker>(new Worker([this](Frame*& f)
+		{
+			Convert(f);
+
+			{
+				std::lock_guard<std::mutex> l(m_lock);
+				f->state = Frame::Ready;
+			}
+			m_cv.notify_all();
+		})));
+	}
+
+	m_writer = std::thread(&GSCaptureStream::WriterProc, this);
+}
+
+GSCaptureStream::~GSCaptureStream()
+{
+	if(m_writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> l(m_lock);
+			m_exit = true;
+		}
+		m_cv.notify_all();
+
+		m_writer.join();
+
+		printf("GSCaptureStream: %llu frames written, capture waited %llu times\n", m_next_out, m_waits);
+	}
+
+	m_workers.clear();
+
+	if(m_fp)
+	{
+		if(m_pipe)
+			pclose(m_fp);
+		else
+			fclose(m_fp);
+	}
+}
+
+void GSCaptureStream::DeliverFrame(const void* bits, int pitch, bool rgba)
+{
+	if(m_fp == NULL)
+		return;
+
+	Frame* f = m_frames[m_next_in % m_frames.size()].get();
+
+	{
+		std::unique_lock<std::mutex> l(m_lock);
+
+		if(f->state != Frame::Free)
+		{
+			m_waits++;
+
+			while(f->state != Frame::Free)
+				m_cv.wait(l);
+		}
+
+		f->state = Frame::Busy;
+	}
+
+	// The mapped texture goes away once we return, this is the only copy of the frame.
+	const uint8* src = (const uint8*)bits;
+	const int row_size = m_width * 4;
+
+	for(int y = 0; y < m_height; y++, src += pitch)
+	{
+		memcpy(&f->in[y * row_size], src, row_size);
+	}
+
+	f->rgba = rgba;
+
+	m_workers[m_next_in % m_workers.size()]->Push(f);
+
+	{
+		std::lock_guard<std::mutex> l(m_lock);
+		m_next_in++;
+	}
+	m_cv.notify_all();
+}
+
+void GSCaptureStream::Convert(Frame* f)
+{
+	const int w = m_width;
+	const int h = m_height;
+	const uint8* src = f->in.data();
+
+	if(m_format == Y4M)
+	{
+		uint8* y = f->out.data();
+		uint8* u = y + w * h;
+		uint8* v = u + w * h / 4;
+
+		for(int i = 0; i < h; i += 2)
+		{
+			ConvertRowsToYUV(&src[i * w * 4], &src[(i + 1) * w * 4], &y[i * w], &y[(i + 1) * w], &u[i / 2 * w / 2], &v[i / 2 * w / 2], w, f->rgba);
+		}
+	}
+	else
+	{
+		uint8* dst = f->out.data();
+		const int r = f->rgba ? 0 : 2;
+		const int b = f->rgba ? 2 : 0;
+
+		for(int i = 0; i < w * h; i++, src += 4, dst += 3)
+		{
+			dst[0] = src[r];
+			dst[1] = src[1];
+			dst[2] = src[b];
+		}
+	}
+}
+
+void GSCaptureStream::WriterProc()
+{
+	std::unique_lock<std::mutex> l(m_lock);
+
+	while(true)
+	{
+		Frame* f = m_frames[m_next_out % m_frames.size()].get();
+
+		while(f->state != Frame::Ready)
+		{
+			if(m_exit && m_next_out == m_next_in)
+				return;
+
+			m_cv.wait(l);
+		}
+
+		l.unlock();
+
+		if(m_format == Y4M)
+		{
+			fwrite("FRAME\n", 1, 6, m_fp);
+		}
+
+		if(fwrite(f->out.data(), 1, f->out.size(), m_fp) != f->out.size())
+		{
+			fprintf(stderr, "GSCaptureStream: Error failed to write frame\n");
+		}
+
+		l.lock();
+
+		f->state = Frame::Free;
+		m_next_out++;
+
+		m_cv.notify_all();
+	}
+}
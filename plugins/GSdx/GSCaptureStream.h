@@ -0,0 +1,80 @@
+/*
+ *	Copyright (C) 2007-2009 Gabest
+ *	http://www.gabest.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with GNU Make; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#pragma once
+
+#include "GSThread_CXX11.h"
+
+// Writes the captured frames as a single Y4M (4:2:0) or raw RGB24 stream, to a file or,
+// when the target starts with '|', to the standard input of a command (e.g. an encoder).
+//
+// Frames are copied once into a ring of frame slots, converted by a pool of workers and
+// written in order by a writer thread. DeliverFrame only blocks when all the slots are
+// still in use.
+class GSCaptureStream
+{
+public:
+	enum Format
+	{
+		Y4M = 1,
+		RGB = 2,
+	};
+
+private:
+	struct Frame
+	{
+		enum {Free, Busy, Ready} state;
+		bool rgba;
+		std::vector<uint8> in;	// w * h * 4 bytes, packed rows
+		std::vector<uint8> out;
+	};
+
+	using Worker = GSJobQueue<Frame*, 16>;
+
+	Format m_format;
+	int m_width;
+	int m_height;
+	FILE* m_fp;
+	bool m_pipe;
+
+	std::vector<std::unique_ptr<Frame>> m_frames;
+	std::vector<std::unique_ptr<Worker>> m_workers;
+	std::thread m_writer;
+
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	uint64 m_next_in;
+	uint64 m_next_out;
+	bool m_exit;
+
+	uint64 m_waits;
+
+	void Convert(Frame* f);
+	void WriterProc();
+
+public:
+	GSCaptureStream(Format format, const std::string& target, int w, int h, float fps, int threads);
+	virtual ~GSCaptureStream();
+
+	bool IsOpen() const {return m_fp != NULL;}
+
+	void DeliverFrame(const void* bits, int pitch, bool rgba);
+};
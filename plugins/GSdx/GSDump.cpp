@@ -119,39 +119,96 @@ void GSDump::AppendRawData(uint8 c)
 
 GSDumpXz::GSDumpXz(const std::string& fn, uint32 crc, const GSFreezeData& fd, const GSPrivRegSet* regs)
 	: GSDumpBase(fn + ".gs.xz")
+	, m_pending(false)
+	, m_exit(false)
 {
+	memset(&m_stats, 0, sizeof(m_stats));
+
 	m_strm = LZMA_STREAM_INIT;
-	lzma_ret ret = lzma_easy_encoder(&m_strm, 6 /*level*/, LZMA_CHECK_CRC64);
+
+	lzma_mt mt;
+	memset(&mt, 0, sizeof(mt));
+	// Each encoder thread needs ~100MB at this level, don't go overboard
+	mt.threads = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1), 4);
+	mt.preset = 6 /*level*/;
+	mt.check = LZMA_CHECK_CRC64;
+
+	lzma_ret ret = lzma_stream_encoder_mt(&m_strm, &mt);
+	if (ret != LZMA_OK) {
+		// liblzma built without threading support, the compression still happens
+		// outside of the GS thread.
+		ret = lzma_easy_encoder(&m_strm, 6 /*level*/, LZMA_CHECK_CRC64);
+	}
 	if (ret != LZMA_OK) {
 		fprintf(stderr, "GSDumpXz: Error initializing LZMA encoder ! (error code %u)\n", ret);
 		return;
 	}
 
+	m_in_buff.reserve(FLUSH_SIZE);
+
+	m_thread = std::thread(&GSDumpXz::ThreadProc, this);
+
 	AddHeader(crc, fd, regs);
 }
 
 GSDumpXz::~GSDumpXz()
 {
-	Flush();
+	if (m_thread.joinable()) {
+		Flush();
 
-	// Finish the stream
-	m_strm.avail_in = 0;
-	Compress(LZMA_FINISH, LZMA_STREAM_END);
+		{
+			std::lock_guard<std::mutex> l(m_lock);
+			m_exit = true;
+		}
+		m_cv.notify_all();
+
+		m_thread.join();
+
+		// Finish the stream
+		m_strm.avail_in = 0;
+		Compress(LZMA_FINISH, LZMA_STREAM_END);
+
+		fprintf(stdout, "GSDumpXz: %llu MB compressed to %llu MB in %llu chunks, GS thread waited %llu times (%llu ms)\n",
+			m_stats.in_bytes >> 20, m_stats.out_bytes >> 20, m_stats.flushes, m_stats.stalls, m_stats.stall_ms);
+	}
 
 	lzma_end(&m_strm);
 }
 
+void GSDumpXz::ThreadProc()
+{
+	std::unique_lock<std::mutex> l(m_lock);
+
+	while (true) {
+		while (!m_pending) {
+			if (m_exit)
+				return;
+
+			m_cv.wait(l);
+		}
+
+		l.unlock();
+
+		m_strm.next_in = m_compress_buff.data();
+		m_strm.avail_in = m_compress_buff.size();
+
+		Compress(LZMA_RUN, LZMA_OK);
+
+		m_compress_buff.clear();
+
+		l.lock();
+		m_pending = false;
+		m_cv.notify_all();
+	}
+}
+
 void GSDumpXz::AppendRawData(const void *data, size_t size)
 {
 	size_t old_size = m_in_buff.size();
 	m_in_buff.resize(old_size + size);
 	memcpy(&m_in_buff[old_size], data, size);
 
-	// Enough data was accumulated, time to write/compress it.  If compression
-	// is enabled, it will freeze PCSX2. 1GB should be enough for long dump.
-	//
-	// Note: long dumps are currently not supported so this path won't be executed
-	if (m_in_buff.size() > 1024*1024*1024)
+	if (m_in_buff.size() >= FLUSH_SIZE)
 		Flush();
 }
 
@@ -162,15 +219,30 @@ void GSDumpXz::AppendRawData(uint8 c)
 
 void GSDumpXz::Flush()
 {
-	if (m_in_buff.empty())
+	if (m_in_buff.empty() || !m_thread.joinable())
 		return;
 
-	m_strm.next_in = m_in_buff.data();
-	m_strm.avail_in = m_in_buff.size();
+	std::unique_lock<std::mutex> l(m_lock);
+
+	if (m_pending) {
+		auto start = std::chrono::steady_clock::now();
+
+		while (m_pending)
+			m_cv.wait(l);
+
+		m_stats.stalls++;
+		m_stats.stall_ms += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	m_stats.in_bytes += m_in_buff.size();
+	m_stats.flushes++;
 
-	Compress(LZMA_RUN, LZMA_OK);
+	// The compressor cleared its buffer, but kept the allocation
+	std::swap(m_in_buff, m_compress_buff);
+	m_pending = true;
 
-	m_in_buff.clear();
+	l.unlock();
+	m_cv.notify_all();
 }
 
 void GSDumpXz::Compress(lzma_action action, lzma_ret expected_status)
@@ -189,6 +261,7 @@ void GSDumpXz::Compress(lzma_action action, lzma_ret expected_status)
 
 		size_t write_size = out_buff.size() - m_strm.avail_out;
 		Write(out_buff.data(), write_size);
+		m_stats.out_bytes += write_size;
 
 	} while (m_strm.avail_out == 0);
 }
@@ -76,12 +76,35 @@ public:
 	virtual ~GSDump() = default;
 };
 
+// The dump data is compressed on a background thread (itself using the multithreaded
+// xz encoder when available). The GS thread only appends to m_in_buff, which is handed
+// over to the compressor in large chunks; it only waits when the compressor is still
+// busy with the previous chunk.
 class GSDumpXz final : public GSDumpBase
 {
-	lzma_stream m_strm;
+	enum {FLUSH_SIZE = 32 * 1024 * 1024};
 
-	std::vector<uint8> m_in_buff;
+	lzma_stream m_strm;
 
+	std::vector<uint8> m_in_buff;		// filled by the GS thread
+	std::vector<uint8> m_compress_buff;	// owned by the compressor while m_pending is set
+
+	std::thread m_thread;
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	bool m_pending;
+	bool m_exit;
+
+	struct
+	{
+		uint64 in_bytes;
+		uint64 out_bytes;
+		uint64 flushes;
+		uint64 stalls;
+		uint64 stall_ms;
+	} m_stats;
+
+	void ThreadProc();
 	void Flush();
 	void Compress(lzma_action action, lzma_ret expected_status);
 	void AppendRawData(const void *data, size_t size);
@@ -484,10 +484,14 @@ GSLocalMemory::GSLocalMemory()
 	m_psm[PSM_PSMZ24].depth  = 1;
 	m_psm[PSM_PSMZ16].depth  = 1;
 	m_psm[PSM_PSMZ16S].depth = 1;
+
+	SetWriteThreads(theApp.GetConfigI("extrathreads_upload"));
 }
 
 GSLocalMemory::~GSLocalMemory()
 {
+	m_wi_workers.clear();
+
 	if (m_use_fifo_alloc)
 		fifo_free(m_vm8, m_vmsize, 4);
 	else
@@ -714,6 +718,85 @@ std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 	return p2t;
 }
 
+void GSLocalMemory::SetWriteThreads(int threads)
+{
+	m_wi_workers.clear();
+
+	for(int i = 0; i < threads; i++)
+	{
+		m_wi_workers.push_back(std::unique_ptr<WriteImageWorker>(new WriteImageWorker(
+			[this](WriteImageJob* &job) { (this->*job->fn)(job->l, job->r, job->y, job->h, job->src, job->srcpitch, job->BITBLTBUF); })));
+	}
+
+	m_wi_jobs.resize(m_wi_workers.size() + 1);
+}
+
+void GSLocalMemory::WriteImageBlockMT(writeImageBlock fn, int psm, int l, int r, int y, int h, const uint8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF)
+{
+	const psm_t& p = m_psm[psm];
+
+	// small transfers are not worth waking up the workers
+
+	const int min_chunk = 32 * 1024;
+
+	int size = ((r - l) * p.trbpp >> 3) * h;
+
+	int chunks = std::min<int>(m_wi_jobs.size(), size / min_chunk);
+
+	// the bands only touch distinct blocks if the rows do not wrap into the next page row and the
+	// block addresses of the destination do not wrap around the local memory, otherwise the order
+	// of the writes matters (a narrow transfer into a wide buffer spans far more than it writes)
+
+	int pw = (int)BITBLTBUF.DBW * 64 / p.pgs.x * p.pgs.x;
+
+	int span = (y + h + p.pgs.y - 1) / p.pgs.y * (pw / p.pgs.x) * 32;
+
+	if(chunks <= 1 || r > pw || span > (int)MAX_BLOCKS)
+	{
+		(this->*fn)(l, r, y, h, src, srcpitch, BITBLTBUF);
+
+		return;
+	}
+
+	int bsy = p.bs.y;
+	int rows = h / bsy;
+	int step = (rows + chunks - 1) / chunks * bsy;
+
+	chunks = (h + step - 1) / step;
+
+	for(int i = 0; i < chunks; i++)
+	{
+		WriteImageJob& job = m_wi_jobs[i];
+
+		int start = i * step;
+
+		job.fn = fn;
+		job.l = l;
+		job.r = r;
+		job.y = y + start;
+		job.h = std::min<int>(step, h - start);
+		job.src = src + srcpitch * start;
+		job.srcpitch = srcpitch;
+		job.BITBLTBUF = BITBLTBUF;
+	}
+
+	for(int i = 1; i < chunks; i++)
+	{
+		m_wi_workers[i - 1]->Push(&m_wi_jobs[i]);
+	}
+
+	WriteImageJob& job = m_wi_jobs[0];
+
+	(this->*fn)(job.l, job.r, job.y, job.h, job.src, job.srcpitch, job.BITBLTBUF);
+
+	// everything must be in memory before WriteImage returns, the next draw or texture update may read it
+
+	for(int i = 1; i < chunks; i++)
+	{
+		m_wi_workers[i - 1]->Wait();
+	}
+}
+
 ////////////////////
 
 template<int psm, int bsx, int bsy, int alignment>
@@ -1028,19 +1111,23 @@ void GSLocalMemory::WriteImage(int& tx, int& ty, const uint8* src, int len, GIFR
 				{
 					size_t addr = (size_t)&s[la * trbpp >> 3];
 
+					writeImageBlock fn;
+
 					if((addr & 31) == 0 && (srcpitch & 31) == 0)
 					{
-						WriteImageBlock<psm, bsx, bsy, 32>(la, ra, ty, h2, s, srcpitch, BITBLTBUF);
+						fn = &GSLocalMemory::WriteImageBlock<psm, bsx, bsy, 32>;
 					}
 					else if((addr & 15) == 0 && (srcpitch & 15) == 0)
 					{
-						WriteImageBlock<psm, bsx, bsy, 16>(la, ra, ty, h2, s, srcpitch, BITBLTBUF);
+						fn = &GSLocalMemory::WriteImageBlock<psm, bsx, bsy, 16>;
 					}
 					else
 					{
-						WriteImageBlock<psm, bsx, bsy, 0>(la, ra, ty, h2, s, srcpitch, BITBLTBUF);
+						fn = &GSLocalMemory::WriteImageBlock<psm, bsx, bsy, 0>;
 					}
 
+					WriteImageBlockMT(fn, psm, la, ra, ty, h2, s, srcpitch, BITBLTBUF);
+
 					s += srcpitch * h2;
 					ty += h2;
 					h -= h2;
@@ -26,6 +26,7 @@
 #include "GSVector.h"
 #include "GSBlock.h"
 #include "GSClut.h"
+#include "GSThread_CXX11.h"
 
 class GSOffset : public GSAlignedClass<32>
 {
@@ -173,6 +174,28 @@ protected:
 
 	//
 
+	// the block aligned middle of large transfers is split into bands of block rows and unswizzled by m_wi_workers in parallel
+
+	typedef void (GSLocalMemory::*writeImageBlock)(int l, int r, int y, int h, const uint8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF);
+
+	struct WriteImageJob
+	{
+		writeImageBlock fn;
+		int l, r, y, h;
+		const uint8* src;
+		int srcpitch;
+		GIFRegBITBLTBUF BITBLTBUF;
+	};
+
+	typedef GSJobQueue<WriteImageJob*, 16> WriteImageWorker;
+
+	std::vector<std::unique_ptr<WriteImageWorker>> m_wi_workers;
+	std::vector<WriteImageJob> m_wi_jobs;
+
+	void WriteImageBlockMT(writeImageBlock fn, int psm, int l, int r, int y, int h, const uint8* src, int srcpitch, const GIFRegBITBLTBUF& BITBLTBUF);
+
+	//
+
 	std::unordered_map<uint32, GSOffset*> m_omap;
 	std::unordered_map<uint32, GSPixelOffset*> m_pomap;
 	std::unordered_map<uint32, GSPixelOffset4*> m_po4map;
@@ -187,6 +210,8 @@ public:
 	GSPixelOffset4* GetPixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF);
 	std::vector<GSVector2i>* GetPage2TileMap(const GIFRegTEX0& TEX0);
 
+	void SetWriteThreads(int threads);
+
 	// address
 
 	static uint32 BlockNumber32(int x, int y, uint32 bp, uint32 bw)
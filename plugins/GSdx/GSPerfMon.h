@@ -35,7 +35,7 @@ public:
 	
 	enum counter_t 
 	{
-		Frame, Prim, Draw, Swizzle, Unswizzle, Fillrate, Quad, SyncPoint,
+		Frame, Prim, Draw, Swizzle, Unswizzle, UnswizzleSkip, TextureHashHit, TextureHashMiss, Fillrate, Quad, SyncPoint, SyncFull, SyncPage,
 		CounterLast,
 	};
 
@@ -220,8 +220,10 @@ void GSState::SetFrameSkip(int skip)
 		m_fpGIFRegHandlers[GIF_A_D_REG_XYZF3] = &GSState::GIFRegHandlerNOP;
 		m_fpGIFRegHandlers[GIF_A_D_REG_XYZ3] = &GSState::GIFRegHandlerNOP;
 
-		m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = &GSState::GIFPackedRegHandlerNOP;
-		m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2] = &GSState::GIFPackedRegHandlerNOP;
+		for(size_t i = 0; i < countof(m_fpGIFPackedRegHandlersC); i++)
+		{
+			m_fpGIFPackedRegHandlersC[i] = &GSState::GIFPackedRegHandlerNOP;
+		}
 	}
 	else
 	{
@@ -301,6 +303,12 @@ void GSState::ResetHandlers()
 		m_fpGIFRegHandlerXYZ[P][3] = &GSState::GIFRegHandlerXYZ2<P, 1, auto_flush>; \
 		m_fpGIFPackedRegHandlerSTQRGBAXYZF2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZF2<P, auto_flush>; \
 		m_fpGIFPackedRegHandlerSTQRGBAXYZ2[P] = &GSState::GIFPackedRegHandlerSTQRGBAXYZ2<P, auto_flush>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_UVRGBAXYZF2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 1, true>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_UVRGBAXYZ2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 1, false>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_RGBAUVXYZF2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 2, true>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_RGBAUVXYZ2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 2, false>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_RGBAXYZF2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 0, true>; \
+		m_fpGIFPackedRegHandlerRGBAUVXYZ[P][GIF_REG_RGBAXYZ2 - GIF_REG_UVRGBAXYZF2] = &GSState::GIFPackedRegHandlerRGBAUVXYZ<P, auto_flush, 0, false>; \
 
 	if (m_userhacks_auto_flush) {
 		SetHandlerXYZ(GS_POINTLIST, true);
@@ -762,6 +770,69 @@ void GSState::GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, uin
 	m_q = r[-3].STQ.Q; // remember the last one, STQ outputs this to the temp Q each time
 }
 
+// uv: 0 - RGBA XYZ, 1 - UV RGBA XYZ, 2 - RGBA UV XYZ
+// ST, Q and FOG don't change within the batch, they are only loaded once.
+template<uint32 prim, bool auto_flush, uint32 uv, bool xyzf>
+void GSState::GIFPackedRegHandlerRGBAUVXYZ(const GIFPackedReg* RESTRICT r, uint32 size)
+{
+	const uint32 nreg = uv ? 3 : 2;
+	const uint32 rgba_index = uv == 1 ? 1 : 0;
+	const uint32 uv_index = uv == 1 ? 0 : 1;
+	const uint32 xyz_index = nreg - 1;
+
+	ASSERT(size > 0 && size % nreg == 0);
+
+	const GIFPackedReg* RESTRICT r_end = r + size;
+
+	GSVector4i st = GSVector4i::loadl(&m_v.ST);
+	GSVector4i q = GSVector4i::cast(GSVector4(m_q));
+	GSVector4i uvv = GSVector4i::load((int)m_v.UV);
+	GSVector4i fog = GSVector4i::load((int)m_v.FOG);
+
+	if(uv && m_userhacks_wildhack)
+	{
+		m_isPackedUV_HackFlag = true; // see GIFPackedRegHandlerUV_Hack
+	}
+
+	while(r < r_end)
+	{
+		GSVector4i rgba = (GSVector4i::load<false>(&r[rgba_index]) & GSVector4i::x000000ff()).ps32().pu16();
+
+		m_v.m[0] = st.upl64(rgba.upl32(q)); // TODO: only store the last one
+
+		if(uv)
+		{
+			GSVector4i v = GSVector4i::loadl(&r[uv_index]) & GSVector4i::x00003fff();
+
+			uvv = v.ps32(v);
+		}
+
+		GSVector4i xy = GSVector4i::loadl(&r[xyz_index].u64[0]);
+
+		if(xyzf)
+		{
+			GSVector4i zf = GSVector4i::loadl(&r[xyz_index].u64[1]);
+			xy = xy.upl16(xy.srl<4>()).upl32(uvv);
+			zf = zf.srl32(4) & GSVector4i::x00ffffff().upl32(GSVector4i::x000000ff());
+
+			m_v.m[1] = xy.upl32(zf); // TODO: only store the last one
+
+			VertexKick<prim, auto_flush>(r[xyz_index].XYZF2.Skip());
+		}
+		else
+		{
+			GSVector4i z = GSVector4i::loadl(&r[xyz_index].u64[1]);
+			GSVector4i xyz = xy.upl16(xy.srl<4>()).upl32(z);
+
+			m_v.m[1] = xyz.upl64(uvv.upl32(fog)); // TODO: only store the last one
+
+			VertexKick<prim, auto_flush>(r[xyz_index].XYZ2.Skip());
+		}
+
+		r += nreg;
+	}
+}
+
 void GSState::GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, uint32 size)
 {
 }
@@ -1641,7 +1712,7 @@ void GSState::FlushPrim()
 
 		if(GSLocalMemory::m_psm[m_context->FRAME.PSM].fmt < 3 && GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt < 3)
 		{
-			m_vt.Update(m_vertex.buff, m_index.buff, m_vertex.tail, m_index.tail, GSUtil::GetPrimClass(PRIM->PRIM));
+			UpdateVertexTrace(GSUtil::GetPrimClass(PRIM->PRIM));
 
 			m_context->SaveReg();
 
@@ -1686,6 +1757,11 @@ void GSState::FlushPrim()
 	}
 }
 
+void GSState::UpdateVertexTrace(GS_PRIM_CLASS primclass)
+{
+	m_vt.Update(m_vertex.buff, m_index.buff, m_vertex.tail, m_index.tail, primclass);
+}
+
 //
 
 void GSState::Write(const uint8* mem, int len)
@@ -2189,16 +2265,15 @@ template<int index> void GSState::Transfer(const uint8* mem, uint32 size)
 						break;
 					
 					case GIFPath::TYPE_STQRGBAXYZF2: // majority of the vertices are formatted like this
-
-						(this->*m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2])((GIFPackedReg*)mem, total);
-
-						mem += total * sizeof(GIFPackedReg);
-
-						break;
-
 					case GIFPath::TYPE_STQRGBAXYZ2:
+					case GIFPath::TYPE_UVRGBAXYZF2:
+					case GIFPath::TYPE_UVRGBAXYZ2:
+					case GIFPath::TYPE_RGBAUVXYZF2:
+					case GIFPath::TYPE_RGBAUVXYZ2:
+					case GIFPath::TYPE_RGBAXYZF2:
+					case GIFPath::TYPE_RGBAXYZ2:
 
-						(this->*m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2])((GIFPackedReg*)mem, total);
+						(this->*m_fpGIFPackedRegHandlersC[path.type - GIFPath::TYPE_STQRGBAXYZF2])((GIFPackedReg*)mem, total);
 
 						mem += total * sizeof(GIFPackedReg);
 
@@ -2604,6 +2679,11 @@ void GSState::UpdateVertexKick()
 
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZF2] = m_fpGIFPackedRegHandlerSTQRGBAXYZF2[prim];
 	m_fpGIFPackedRegHandlersC[GIF_REG_STQRGBAXYZ2] = m_fpGIFPackedRegHandlerSTQRGBAXYZ2[prim];
+
+	for(uint32 i = GIF_REG_UVRGBAXYZF2; i < GIF_REG_COMPLEX_COUNT; i++)
+	{
+		m_fpGIFPackedRegHandlersC[i] = m_fpGIFPackedRegHandlerRGBAUVXYZ[prim][i - GIF_REG_UVRGBAXYZF2];
+	}
 }
 
 void GSState::GrowVertexBuffer()
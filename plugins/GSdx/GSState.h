@@ -75,12 +75,14 @@ class GSState : public GSAlignedClass<32>
 
 	typedef void (GSState::*GIFPackedRegHandlerC)(const GIFPackedReg* RESTRICT r, uint32 size);
 
-	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[2];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlersC[GIF_REG_COMPLEX_COUNT];
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZF2[8];
 	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerSTQRGBAXYZ2[8];
+	GIFPackedRegHandlerC m_fpGIFPackedRegHandlerRGBAUVXYZ[8][GIF_REG_COMPLEX_COUNT - GIF_REG_UVRGBAXYZF2];
 
 	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerSTQRGBAXYZF2(const GIFPackedReg* RESTRICT r, uint32 size);
 	template<uint32 prim, bool auto_flush> void GIFPackedRegHandlerSTQRGBAXYZ2(const GIFPackedReg* RESTRICT r, uint32 size);
+	template<uint32 prim, bool auto_flush, uint32 uv, bool xyzf> void GIFPackedRegHandlerRGBAUVXYZ(const GIFPackedReg* RESTRICT r, uint32 size);
 	void GIFPackedRegHandlerNOP(const GIFPackedReg* RESTRICT r, uint32 size);
 
 	template<int i> void ApplyTEX0(GIFRegTEX0& TEX0);
@@ -258,6 +260,7 @@ public:
 	void Flush();
 	void FlushPrim();
 	void FlushWrite();
+	virtual void UpdateVertexTrace(GS_PRIM_CLASS primclass);
 	virtual void Draw() = 0;
 	virtual void PurgePool() = 0;
 	virtual void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r) {}
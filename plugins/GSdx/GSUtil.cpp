@@ -209,6 +209,52 @@ bool GSUtil::HasCompatibleBits(uint32 spsm, uint32 dpsm)
 	return (s_maps.CompatibleBitsField[spsm][dpsm >> 5] & (1 << (dpsm & 0x1f))) != 0;
 }
 
+// 64-bit content hash of texture data, used to tell apart re-uploads of the same data.
+// Four independent lanes keep it memory bound, size should be a multiple of 8 bytes.
+
+uint64 GSUtil::Hash(const void* data, size_t size)
+{
+	const uint64 P1 = 0x9e3779b185ebca87ull;
+	const uint64 P2 = 0xc2b2ae3d27d4eb4full;
+	const uint64 P3 = 0x165667b19e3779f9ull;
+
+	#define ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+	#define ROUND64(acc, v) (ROTL64((acc) + (v) * P2, 31) * P1)
+
+	const uint64* RESTRICT p = (const uint64*)data;
+
+	uint64 a = P1 + P2;
+	uint64 b = P2;
+	uint64 c = 0;
+	uint64 d = 0 - P1;
+
+	for(size_t i = size >> 5; i > 0; i--, p += 4)
+	{
+		a = ROUND64(a, p[0]);
+		b = ROUND64(b, p[1]);
+		c = ROUND64(c, p[2]);
+		d = ROUND64(d, p[3]);
+	}
+
+	uint64 h = ROTL64(a, 1) + ROTL64(b, 7) + ROTL64(c, 12) + ROTL64(d, 18) + size;
+
+	for(size_t i = (size & 31) >> 3; i > 0; i--, p++)
+	{
+		h = ROTL64(h ^ ROUND64(0, p[0]), 27) * P1 + P3;
+	}
+
+	#undef ROUND64
+	#undef ROTL64
+
+	h ^= h >> 33;
+	h *= P2;
+	h ^= h >> 29;
+	h *= P3;
+	h ^= h >> 32;
+
+	return h;
+}
+
 bool GSUtil::CheckSSE()
 {
 	bool status = true;
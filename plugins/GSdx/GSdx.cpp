@@ -329,6 +329,8 @@ void GSdxApp::Init()
 	m_default_configuration["AspectRatio"]                                = "1";
 	m_default_configuration["autoflush_sw"]                               = "1";
 	m_default_configuration["capture_enabled"]                            = "0";
+	m_default_configuration["capture_file"]                               = "";
+	m_default_configuration["capture_format"]                             = "0";
 	m_default_configuration["capture_out_dir"]                            = "/tmp/GSdx_Capture";
 	m_default_configuration["capture_threads"]                            = "4";
 	m_default_configuration["CaptureHeight"]                              = "480";
@@ -338,11 +340,13 @@ void GSdxApp::Init()
 	m_default_configuration["CrcHacksExclusions"]                         = "";
 	m_default_configuration["debug_glsl_shader"]                          = "0";
 	m_default_configuration["debug_opengl"]                               = "0";
+	m_default_configuration["debug_sw_sync"]                              = "0";
 	m_default_configuration["disable_hw_gl_draw"]                         = "0";
 	m_default_configuration["dithering_ps2"]                              = "2";
 	m_default_configuration["dump"]                                       = "0";
 	m_default_configuration["extrathreads"]                               = "2";
 	m_default_configuration["extrathreads_height"]                        = "4";
+	m_default_configuration["extrathreads_upload"]                        = "2";
 	m_default_configuration["filter"]                                     = std::to_string(static_cast<int8>(BiFiltering::PS2));
 	m_default_configuration["force_texture_clear"]                        = "0";
 	m_default_configuration["fxaa"]                                       = "0";
@@ -405,6 +409,8 @@ void GSdxApp::Init()
 	m_default_configuration["shaderfx"]                                   = "0";
 	m_default_configuration["shaderfx_conf"]                              = "shaders/GSdx_FX_Settings.ini";
 	m_default_configuration["shaderfx_glsl"]                              = "shaders/GSdx.fx";
+	m_default_configuration["texture_hash_hw"]                            = "0";
+	m_default_configuration["texture_hash_sw"]                            = "0";
 	m_default_configuration["TVShader"]                                   = "0";
 	m_default_configuration["upscale_multiplier"]                         = "1";
 	m_default_configuration["UserHacks"]                                  = "0";
@@ -512,6 +518,13 @@ void GSdxApp::SetConfigDir(const char* dir)
 	}
 }
 
+std::string GSdxApp::GetConfigDir() const
+{
+	size_t pos = m_ini.find_last_of(DIRECTORY_SEPARATOR);
+
+	return pos != std::string::npos ? m_ini.substr(0, pos + 1) : std::string();
+}
+
 std::string GSdxApp::GetConfigS(const char* entry)
 {
 	char buff[4096] = {0};
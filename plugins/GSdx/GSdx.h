@@ -64,6 +64,7 @@ public:
 	GSRendererType GetCurrentRendererType() const;
 
 	void SetConfigDir(const char* dir);
+	std::string GetConfigDir() const;
 
 	std::vector<GSSetting> m_gs_renderers;
 	std::vector<GSSetting> m_gs_interlace;
@@ -28,6 +28,17 @@
 
 #include "Renderers/SW/GSScanlineEnvironment.h"
 
+#if defined(ENABLE_PERF_JITDUMP) && defined(BUILTIN_GS_PLUGIN)
+
+// common/include/Utilities/Perf.h (where uptr is uintptr_t), the core links it when
+// GSdx is built in
+namespace Perf
+{
+	void jit_load(uintptr_t x86, uint32 size, const char* symbol);
+}
+
+#endif
+
 template<class KEY, class VALUE> class GSFunctionMap
 {
 protected:
@@ -35,6 +46,9 @@ protected:
 	{
 		uint64 frame, frames;
 		uint64 ticks, actual, total;
+		uint64 draws;
+		uint32 epoch;
+		bool prewarmed;
 		VALUE f;
 	};
 
@@ -42,12 +56,15 @@ protected:
 	std::unordered_map<KEY, ActivePtr*> m_map_active;
 
 	ActivePtr* m_active;
+	uint32 m_epoch;
 
 	virtual VALUE GetDefaultFunction(KEY key) = 0;
+	virtual bool IsPrewarmed(KEY key) {return false;}
 
 public:
 	GSFunctionMap()
 		: m_active(NULL)
+		, m_epoch(0)
 	{
 	}
 
@@ -78,14 +95,37 @@ public:
 
 			p->f = i != m_map.end() ? i->second : GetDefaultFunction(key);
 
+			p->prewarmed = i == m_map.end() && IsPrewarmed(key);
+
 			m_map_active[key] = p;
 
 			m_active = p;
 		}
 
+		m_active->epoch = m_epoch;
+
 		return m_active->f;
 	}
 
+	// Keys of the generated functions looked up since the last ResetUsedKeys.
+	// Not thread safe, the owner of the map must be idle.
+
+	void ResetUsedKeys()
+	{
+		m_epoch++;
+	}
+
+	void GetUsedKeys(std::vector<KEY>& keys)
+	{
+		for(const auto& i : m_map_active)
+		{
+			if(i.second->epoch == m_epoch && m_map.find(i.first) == m_map.end())
+			{
+				keys.push_back(i.first);
+			}
+		}
+	}
+
 	void UpdateStats(uint64 frame, uint64 ticks, int actual, int total)
 	{
 		if(m_active)
@@ -96,6 +136,7 @@ public:
 				m_active->frames++;
 			}
 
+			m_active->draws++;
 			m_active->ticks += ticks;
 			m_active->actual += actual;
 			m_active->total += total;
@@ -107,6 +148,7 @@ public:
 	virtual void PrintStats()
 	{
 		uint64 ttpf = 0;
+		uint64 draws = 0, prewarmed_draws = 0;
 
 		for(const auto &i : m_map_active)
 		{
@@ -116,9 +158,17 @@ public:
 			{
 				ttpf += p->ticks / p->frames;
 			}
+
+			draws += p->draws;
+
+			if(p->prewarmed)
+			{
+				prewarmed_draws += p->draws;
+			}
 		}
 
 		printf("GS stats\n");
+		printf("%llu of %llu draws used pre-warmed code\n", prewarmed_draws, draws);
 
 		for (const auto &i : m_map_active)
 		{
@@ -131,8 +181,8 @@ public:
 				uint64 tpf = p->frames > 0 ? p->ticks / p->frames : 0;
 				uint64 ppf = p->frames > 0 ? p->actual / p->frames : 0;
 
-				printf("[%014llx]%c %6.2f%% %5.2f%% f %4llu t %12llu p %12llu w %12lld tpp %4llu tpf %9llu ppf %9llu\n",
-					(uint64)key, m_map.find(key) == m_map.end() ? '*' : ' ',
+				printf("[%014llx]%c%c %6.2f%% %5.2f%% f %4llu t %12llu p %12llu w %12lld tpp %4llu tpf %9llu ppf %9llu\n",
+					(uint64)key, m_map.find(key) == m_map.end() ? '*' : ' ', p->prewarmed ? 'p' : ' ',
 					(float)(tpf * 10000 / 34000000) / 100,
 					(float)(tpf * 10000 / ttpf) / 100,
 					p->frames, p->ticks, p->actual, p->total - p->actual,
@@ -163,18 +213,105 @@ class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 	GSCodeBuffer m_cb;
 	size_t m_total_code_size;
 
+	// Code may be generated ahead of time on a background thread (see Prewarm), m_lock
+	// protects m_cgmap and m_cb against the draw thread.
+	std::mutex m_lock;
+	std::unordered_set<uint64> m_prewarmed;
+	std::thread m_prewarm_thread;
+	std::atomic<bool> m_prewarm_abort;
+
 	enum {MAX_SIZE = 8192};
 
+	VALUE Generate(KEY key)
+	{
+		void* code_ptr = m_cb.GetBuffer(MAX_SIZE);
+
+		CG* cg = new CG(m_param, key, code_ptr, MAX_SIZE);
+		ASSERT(cg->getSize() < MAX_SIZE);
+
+#if 0
+		fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg->getSize(), (uint64)key);
+		GSScanlineSelector sel(key);
+		sel.Print();
+#endif
+
+		m_total_code_size += cg->getSize();
+
+		m_cb.ReleaseBuffer(cg->getSize());
+
+		VALUE ret = (VALUE)cg->getCode();
+
+		m_cgmap[key] = ret;
+
+		#ifdef ENABLE_VTUNE
+
+		// vtune method registration
+
+		// if(iJIT_IsProfilingActive()) // always > 0
+		{
+			std::string name = format("%s<%016llx>()", m_name.c_str(), (uint64)key);
+
+			iJIT_Method_Load ml;
+
+			memset(&ml, 0, sizeof(ml));
+
+			ml.method_id = iJIT_GetNewMethodID();
+			ml.method_name = (char*)name.c_str();
+			ml.method_load_address = (void*)cg->getCode();
+			ml.method_size = (unsigned int)cg->getSize();
+
+			iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, &ml);
+/*
+			name = format("c:/temp1/%s_%016llx.bin", m_name.c_str(), (uint64)key);
+
+			if(FILE* fp = fopen(name.c_str(), "wb"))
+			{
+				fputc(0x0F, fp); fputc(0x0B, fp);
+				fputc(0xBB, fp); fputc(0x6F, fp); fputc(0x00, fp); fputc(0x00, fp); fputc(0x00, fp);
+				fputc(0x64, fp); fputc(0x67, fp); fputc(0x90, fp);
+
+				fwrite(cg->getCode(), cg->getSize(), 1, fp);
+
+				fputc(0xBB, fp); fputc(0xDE, fp); fputc(0x00, fp); fputc(0x00, fp); fputc(0x00, fp);
+				fputc(0x64, fp); fputc(0x67, fp); fputc(0x90, fp);
+				fputc(0x0F, fp); fputc(0x0B, fp);
+
+				fclose(fp);
+			}
+*/
+		}
+
+		#endif
+
+		#if defined(ENABLE_PERF_JITDUMP) && defined(BUILTIN_GS_PLUGIN)
+
+		Perf::jit_load((uintptr_t)cg->getCode(), (uint32)cg->getSize(), format("%s<%016llx>()", m_name.c_str(), (uint64)key).c_str());
+
+		#endif
+
+		delete cg;
+
+		return ret;
+	}
+
 public:
 	GSCodeGeneratorFunctionMap(const char* name, void* param)
 		: m_name(name)
 		, m_param(param)
 		, m_total_code_size(0)
+		, m_prewarm_abort(false)
 	{
 	}
 
 	~GSCodeGeneratorFunctionMap()
 	{
+		m_prewarm_abort = true;
+
+		if(m_prewarm_thread.joinable())
+		{
+			m_prewarm_thread.join();
+		}
+
 #ifdef _DEBUG
 		fprintf(stderr, "%s generated %zu bytes of instruction\n", m_name.c_str(), m_total_code_size);
 #endif
@@ -182,78 +319,52 @@ public:
 
 	VALUE GetDefaultFunction(KEY key)
 	{
-		VALUE ret = NULL;
+		std::lock_guard<std::mutex> lock(m_lock);
 
 		auto i = m_cgmap.find(key);
 
-		if(i != m_cgmap.end())
-		{
-			ret = i->second;
-		}
-		else
-		{
-			void* code_ptr = m_cb.GetBuffer(MAX_SIZE);
-
-			CG* cg = new CG(m_param, key, code_ptr, MAX_SIZE);
-			ASSERT(cg->getSize() < MAX_SIZE);
-
-#if 0
-			fprintf(stderr, "%s Location:%p Size:%zu Key:%llx\n", m_name.c_str(), code_ptr, cg->getSize(), (uint64)key);
-			GSScanlineSelector sel(key);
-			sel.Print();
-#endif
-
-			m_total_code_size += cg->getSize();
+		return i != m_cgmap.end() ? i->second : Generate(key);
+	}
 
-			m_cb.ReleaseBuffer(cg->getSize());
+	bool IsPrewarmed(KEY key)
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
 
-			ret = (VALUE)cg->getCode();
+		return m_prewarmed.find(key) != m_prewarmed.end();
+	}
 
-			m_cgmap[key] = ret;
+	// Generates the code for the given keys on a background thread, so that it is ready
+	// by the time the keys are first drawn with. Keys requested by the draw thread in the
+	// meantime are simply generated there, as before.
+	void Prewarm(const std::vector<KEY>& keys)
+	{
+		m_prewarm_abort = true;
 
-			#ifdef ENABLE_VTUNE
+		if(m_prewarm_thread.joinable())
+		{
+			m_prewarm_thread.join();
+		}
 
-			// vtune method registration
+		m_prewarm_abort = false;
 
-			// if(iJIT_IsProfilingActive()) // always > 0
+		m_prewarm_thread = std::thread([this, keys]()
+		{
+			for(KEY key : keys)
 			{
-				std::string name = format("%s<%016llx>()", m_name.c_str(), (uint64)key);
-
-				iJIT_Method_Load ml;
-
-				memset(&ml, 0, sizeof(ml));
-
-				ml.method_id = iJIT_GetNewMethodID();
-				ml.method_name = (char*)name.c_str();
-				ml.method_load_address = (void*)cg->getCode();
-				ml.method_size = (unsigned int)cg->getSize();
-
-				iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, &ml);
-/*
-				name = format("c:/temp1/%s_%016llx.bin", m_name.c_str(), (uint64)key);
-
-				if(FILE* fp = fopen(name.c_str(), "wb"))
+				if(m_prewarm_abort)
 				{
-					fputc(0x0F, fp); fputc(0x0B, fp);
-					fputc(0xBB, fp); fputc(0x6F, fp); fputc(0x00, fp); fputc(0x00, fp); fputc(0x00, fp);
-					fputc(0x64, fp); fputc(0x67, fp); fputc(0x90, fp);
+					break;
+				}
 
-					fwrite(cg->getCode(), cg->getSize(), 1, fp);
+				std::lock_guard<std::mutex> lock(m_lock);
 
-					fputc(0xBB, fp); fputc(0xDE, fp); fputc(0x00, fp); fputc(0x00, fp); fputc(0x00, fp);
-					fputc(0x64, fp); fputc(0x67, fp); fputc(0x90, fp);
-					fputc(0x0F, fp); fputc(0x0B, fp);
+				if(m_cgmap.find(key) == m_cgmap.end())
+				{
+					Generate(key);
 
-					fclose(fp);
+					m_prewarmed.insert(key);
 				}
-*/
 			}
-
-			#endif
-
-			delete cg;
-		}
-
-		return ret;
+		});
 	}
 };
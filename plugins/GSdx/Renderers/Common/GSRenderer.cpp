@@ -375,6 +375,21 @@ void GSRenderer::VSync(int field)
 				m_perfmon.Get(GSPerfMon::Unswizzle) / 1024
 			);
 
+			double skipped = m_perfmon.Get(GSPerfMon::UnswizzleSkip);
+
+			if(skipped > 0)
+			{
+				s += format(" (%.2f reused)", skipped / 1024);
+			}
+
+			double full = m_perfmon.Get(GSPerfMon::SyncFull);
+			double waits = m_perfmon.Get(GSPerfMon::SyncPage);
+
+			if(full > 0 || waits > 0)
+			{
+				s += format(" | %d full / %d page waits", (int)full, (int)waits);
+			}
+
 			double fillrate = m_perfmon.Get(GSPerfMon::Fillrate);
 
 			if(fillrate > 0)
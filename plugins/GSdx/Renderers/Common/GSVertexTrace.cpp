@@ -59,6 +59,51 @@ GSVertexTrace::GSVertexTrace(const GSState* state)
 	InitUpdate(GS_SPRITE_CLASS);
 }
 
+void GSVertexTrace::MinMax::Init()
+{
+	tmin = s_minmax.xxxx();
+	tmax = s_minmax.yyyy();
+	cmin = GSVector4i::xffffffff();
+	cmax = GSVector4i::zero();
+
+	#if _M_SSE >= 0x401
+
+	pmin = GSVector4i::xffffffff();
+	pmax = GSVector4i::zero();
+
+	#else
+
+	pmin = s_minmax.xxxx();
+	pmax = s_minmax.yyyy();
+
+	#endif
+}
+
+void GSVertexTrace::MinMax::Merge(const MinMax& mm)
+{
+	tmin = tmin.min(mm.tmin);
+	tmax = tmax.max(mm.tmax);
+	cmin = cmin.min_u8(mm.cmin);
+	cmax = cmax.max_u8(mm.cmax);
+
+	#if _M_SSE >= 0x401
+
+	pmin = pmin.min_u32(mm.pmin);
+	pmax = pmax.max_u32(mm.pmax);
+
+	#else
+
+	pmin = pmin.min(mm.pmin);
+	pmax = pmax.max(mm.pmax);
+
+	#endif
+}
+
+bool GSVertexTrace::IsColorTraced() const
+{
+	return !(m_state->PRIM->TME && m_state->m_context->TEX0.TFX == TFX_DECAL && m_state->m_context->TEX0.TCC);
+}
+
 void GSVertexTrace::Update(const void* vertex, const uint32* index, int v_count, int i_count, GS_PRIM_CLASS primclass)
 {
 	m_primclass = primclass;
@@ -66,17 +111,35 @@ void GSVertexTrace::Update(const void* vertex, const uint32* index, int v_count,
 	uint32 iip = m_state->PRIM->IIP;
 	uint32 tme = m_state->PRIM->TME;
 	uint32 fst = m_state->PRIM->FST;
-	uint32 color = !(m_state->PRIM->TME && m_state->m_context->TEX0.TFX == TFX_DECAL && m_state->m_context->TEX0.TCC);
+	uint32 color = IsColorTraced();
 
 	(this->*m_fmm[m_accurate_stq][color][fst][tme][iip][primclass])(vertex, index, i_count);
 
+	UpdateDerived(vertex, index, v_count, i_count);
+}
+
+// mm was collected by the caller while it was walking the vertices anyway (GSRendererSW converts and traces in one pass)
+
+void GSVertexTrace::Update(const MinMax& mm, const void* vertex, const uint32* index, int v_count, int i_count, GS_PRIM_CLASS primclass)
+{
+	m_primclass = primclass;
+
+	SetMinMax(mm, m_state->PRIM->TME, m_state->PRIM->FST, IsColorTraced());
+
+	UpdateDerived(vertex, index, v_count, i_count);
+}
+
+void GSVertexTrace::UpdateDerived(const void* vertex, const uint32* index, int v_count, int i_count)
+{
+	uint32 fst = m_state->PRIM->FST;
+
 	// Potential float overflow detected. Better uses the slower division instead
 	// Note: If Q is too big, 1/Q will end up as 0. 1e30 is a random number
 	// that feel big enough.
 	if (!fst && !m_accurate_stq && m_min.t.z > 1e30) {
 		fprintf(stderr, "Vertex Trace: float overflow detected ! min %e max %e\n", m_min.t.z, m_max.t.z);
 		m_accurate_stq = true;
-		(this->*m_fmm[m_accurate_stq][color][fst][tme][iip][primclass])(vertex, index, i_count);
+		(this->*m_fmm[m_accurate_stq][IsColorTraced()][fst][m_state->PRIM->TME][m_state->PRIM->IIP][m_primclass])(vertex, index, i_count);
 	}
 
 	m_eq.value = (m_min.c == m_max.c).mask() | ((m_min.p == m_max.p).mask() << 16) | ((m_min.t == m_max.t).mask() << 20);
@@ -157,8 +220,6 @@ void GSVertexTrace::Update(const void* vertex, const uint32* index, int v_count,
 template<GS_PRIM_CLASS primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
 void GSVertexTrace::FindMinMax(const void* vertex, const uint32* index, int count)
 {
-	const GSDrawingContext* context = m_state->m_context;
-
 	int n = 1;
 
 	switch(primclass)
@@ -516,6 +577,39 @@ void GSVertexTrace::FindMinMax(const void* vertex, const uint32* index, int coun
 		}
 	}
 
+	MinMax mm;
+
+	mm.tmin = tmin;
+	mm.tmax = tmax;
+	mm.cmin = cmin;
+	mm.cmax = cmax;
+	mm.pmin = pmin;
+	mm.pmax = pmax;
+
+	SetMinMax(mm, tme, fst, color);
+}
+
+void GSVertexTrace::SetMinMax(const MinMax& mm, uint32 tme, uint32 fst, uint32 color)
+{
+	const GSDrawingContext* context = m_state->m_context;
+
+	GSVector4 tmin = mm.tmin;
+	GSVector4 tmax = mm.tmax;
+	GSVector4i cmin = mm.cmin;
+	GSVector4i cmax = mm.cmax;
+
+	#if _M_SSE >= 0x401
+
+	GSVector4i pmin = mm.pmin;
+	GSVector4i pmax = mm.pmax;
+
+	#else
+
+	GSVector4 pmin = mm.pmin;
+	GSVector4 pmax = mm.pmax;
+
+	#endif
+
 	// FIXME/WARNING. A division by 2 is done on the depth. I suspect to avoid
 	// negative value. However it means that we lost the lsb bit. m_eq.z could
 	// be true if depth isn't constant but close enough. It also imply that
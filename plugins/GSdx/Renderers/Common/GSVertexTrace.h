@@ -38,6 +38,27 @@ public:
 	struct VertexAlpha {int min, max; bool valid;};
 	bool m_accurate_stq;
 
+	// raw ranges as they are collected from GSVertex, before offset and scale
+
+	struct alignas(16) MinMax
+	{
+		GSVector4 tmin, tmax;
+		GSVector4i cmin, cmax;
+
+		#if _M_SSE >= 0x401
+
+		GSVector4i pmin, pmax;
+
+		#else
+
+		GSVector4 pmin, pmax;
+
+		#endif
+
+		void Init();
+		void Merge(const MinMax& mm);
+	};
+
 protected:
 	const GSState* m_state;
 
@@ -50,6 +71,9 @@ protected:
 	template<GS_PRIM_CLASS primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
 	void FindMinMax(const void* vertex, const uint32* index, int count);
 
+	void SetMinMax(const MinMax& mm, uint32 tme, uint32 fst, uint32 color);
+	void UpdateDerived(const void* vertex, const uint32* index, int v_count, int i_count);
+
 public:
 	GS_PRIM_CLASS m_primclass;
 
@@ -78,7 +102,9 @@ public:
 	virtual ~GSVertexTrace() {}
 
 	void Update(const void* vertex, const uint32* index, int v_count, int i_count, GS_PRIM_CLASS primclass);
+	void Update(const MinMax& mm, const void* vertex, const uint32* index, int v_count, int i_count, GS_PRIM_CLASS primclass);
 
+	bool IsColorTraced() const;
 	bool IsLinear() const {return m_filter.opt_linear;}
 	bool IsRealLinear() const {return m_filter.linear;}
 
@@ -50,6 +50,9 @@ GSTextureCache::GSTextureCache(GSRenderer* r)
 	}
 
 	m_paltex = theApp.GetConfigB("paltex");
+
+	// Full mipmapping uploads the layers into the source texture separately, they are not part of the hash
+	m_texture_hash = theApp.GetConfigB("texture_hash_hw") && theApp.GetConfigI("mipmap_hw") != static_cast<int>(HWMipmapLevel::Full);
 	m_crc_hack_level = theApp.GetConfigT<CRCHackLevel>("crc_hack_level");
 	if (m_crc_hack_level == CRCHackLevel::Automatic)
 		m_crc_hack_level = GSUtil::GetRecommendedCRCHackLevel(theApp.GetCurrentRendererType());
@@ -87,6 +90,13 @@ void GSTextureCache::RemoveAll()
 {
 	m_src.RemoveAll();
 
+	for (auto& i : m_hash_cache) {
+		ASSERT(i.second.refcount == 0);
+		m_renderer->m_dev->Recycle(i.second.texture);
+	}
+
+	m_hash_cache.clear();
+
 	for(int type = 0; type < 2; type++)
 	{
 		for (auto t : m_dst[type]) delete t;
@@ -455,7 +465,8 @@ GSTextureCache::Source* GSTextureCache::LookupSource(const GIFRegTEX0& TEX0, con
 		AttachPaletteToSource(src, psm_s.pal, true);
 	}
 
-	src->Update(r);
+	// Textures of the hash cache are always complete, other sources may use any part of them
+	src->Update(src->m_from_hash_cache ? GSVector4i(0, 0, 1 << TEX0.TW, 1 << TEX0.TH) : r);
 
 	m_src.m_used = true;
 
@@ -841,8 +852,9 @@ void GSTextureCache::InvalidateVideoMem(GSOffset* off, const GSVector4i& rect, b
 
 				if(!s->m_target)
 				{
-					if(m_disable_partial_invalidation && s->m_repeating)
+					if((m_disable_partial_invalidation && s->m_repeating) || s->m_from_hash_cache)
 					{
+						// A shared texture can't be partially updated, the next lookup will hash the new content
 						m_src.RemoveAt(s);
 					}
 					else
@@ -1160,6 +1172,18 @@ void GSTextureCache::IncAge()
 
 	m_src.m_used = false;
 
+	// Keep unused content for a while, it is usually uploaded again by the time the old source expired
+	for (auto i = m_hash_cache.begin(); i != m_hash_cache.end(); ) {
+		HashCacheEntry& e = i->second;
+
+		if (e.refcount == 0 && ++e.age > 30) {
+			m_renderer->m_dev->Recycle(e.texture);
+			i = m_hash_cache.erase(i);
+		} else {
+			++i;
+		}
+	}
+
 	// Clearing of Rendertargets causes flickering in many scene transitions.
 	// Sigh, this seems to be used to invalidate surfaces. So set a huge maxage to avoid flicker,
 	// but still invalidate surfaces. (Disgaea 2 fmv when booting the game through the BIOS)
@@ -1511,6 +1535,26 @@ GSTextureCache::Source* GSTextureCache::CreateSource(const GIFRegTEX0& TEX0, con
 		dst->m_texture->OffsetHack_modx = modx;
 		dst->m_texture->OffsetHack_mody = mody;
 	}
+	else if (m_texture_hash)
+	{
+		bool hit;
+
+		src->m_from_hash_cache = LookupHashCache(TEX0, TEXA, hit);
+		src->m_texture = src->m_from_hash_cache->texture;
+
+		if (psm.pal > 0)
+		{
+			AttachPaletteToSource(src, psm.pal, m_paltex);
+		}
+
+		if (hit)
+		{
+			// Nothing to upload, LookupSource would fill the whole texture on a miss
+			src->m_complete = true;
+
+			m_renderer->m_perfmon.Put(GSPerfMon::UnswizzleSkip, std::max(tw, psm.bs.x) * std::max(th, psm.bs.y) << (src->m_palette ? 0 : 2));
+		}
+	}
 	else
 	{
 		if (m_paltex && psm.pal > 0)
@@ -1566,8 +1610,11 @@ void GSTextureCache::PrintMemoryUsage()
 	uint32 tex_rt = 0;
 	uint32 rt     = 0;
 	uint32 dss    = 0;
+	for(auto& i : m_hash_cache) {
+		tex += i.second.texture->GetMemUsage();
+	}
 	for(auto s : m_src.m_surfaces) {
-		if(s && !s->m_shared_texture) {
+		if(s && !s->m_shared_texture && !s->m_from_hash_cache) {
 			if(s->m_target)
 				tex_rt += s->m_texture->GetMemUsage();
 			else
@@ -1641,6 +1688,7 @@ GSTextureCache::Source::Source(GSRenderer* r, const GIFRegTEX0& TEX0, const GIFR
 	, m_p2t(NULL)
 	, m_from_target(NULL)
 	, m_from_target_TEX0(TEX0)
+	, m_from_hash_cache(NULL)
 {
 	m_TEX0 = TEX0;
 	m_TEXA = TEXA;
@@ -1676,6 +1724,11 @@ GSTextureCache::Source::Source(GSRenderer* r, const GIFRegTEX0& TEX0, const GIFR
 GSTextureCache::Source::~Source()
 {
 	_aligned_free(m_write.rect);
+
+	if (m_from_hash_cache) {
+		m_from_hash_cache->refcount--;
+		m_texture = NULL; // not ours to recycle
+	}
 }
 
 void GSTextureCache::Source::Update(const GSVector4i& rect, int layer)
@@ -2285,3 +2338,87 @@ void GSTextureCache::PaletteMap::Clear() {
 	}
 }
 
+// GSTextureCache::HashCacheKey
+
+bool GSTextureCache::HashCacheKey::operator==(const HashCacheKey& key) const {
+	return hash == key.hash && clut == key.clut && texa == key.texa && tex == key.tex;
+}
+
+std::size_t GSTextureCache::HashCacheKeyHash::operator()(const HashCacheKey& key) const {
+	// The members are hashes already, just mix them
+	return (std::size_t)(key.hash ^ (key.clut * 31) ^ (key.texa * 131) ^ ((uint64)key.tex << 32));
+}
+
+// Hash the GS memory blocks of the texture in texture order, the same content at another address
+// (or with another buffer width) gives the same hash.
+uint64 GSTextureCache::HashTexture(const GIFRegTEX0& TEX0)
+{
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+	const GSOffset* off = m_renderer->m_context->offset.tex;
+	const GSLocalMemory& mem = m_renderer->m_mem;
+
+	const GSVector2i& bs = psm.bs;
+
+	int tw = std::max<int>(1 << TEX0.TW, bs.x);
+	int th = std::max<int>(1 << TEX0.TH, bs.y);
+
+	uint64 hash = 0;
+
+	for (int y = 0; y < th; y += bs.y) {
+		uint32 base = off->block.row[y >> 3u];
+
+		for (int x = 0; x < tw; x += bs.x) {
+			uint32 block = base + off->block.col[x >> 3u];
+
+			if (block < MAX_BLOCKS || m_wrap_gs_mem) {
+				hash = (hash ^ GSUtil::Hash(mem.BlockPtr(block % MAX_BLOCKS), 256)) * 0x9e3779b97f4a7c15ull;
+			}
+		}
+	}
+
+	return hash;
+}
+
+// Returns the shared texture of the content currently at TEX0. On a miss an empty texture is added,
+// the caller has to upload it.
+GSTextureCache::HashCacheEntry* GSTextureCache::LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& hit)
+{
+	const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[TEX0.PSM];
+
+	bool paltex = m_paltex && psm.pal > 0;
+
+	HashCacheKey key;
+
+	key.hash = HashTexture(TEX0);
+	key.clut = psm.pal > 0 && !paltex ? GSUtil::Hash((const uint32*)m_renderer->m_mem.m_clut, psm.pal * sizeof(uint32)) : 0;
+	key.texa = psm.pal == 0 && psm.fmt > 0 ? TEXA.u64 : 0;
+	key.tex = TEX0.PSM | (TEX0.TW << 8) | (TEX0.TH << 12);
+
+	auto i = m_hash_cache.find(key);
+
+	if (i != m_hash_cache.end()) {
+		m_renderer->m_perfmon.Put(GSPerfMon::TextureHashHit, 1);
+
+		hit = true;
+
+		i->second.refcount++;
+		i->second.age = 0;
+
+		return &i->second;
+	}
+
+	m_renderer->m_perfmon.Put(GSPerfMon::TextureHashMiss, 1);
+
+	hit = false;
+
+	int tw = 1 << TEX0.TW;
+	int th = 1 << TEX0.TH;
+
+	HashCacheEntry e;
+
+	e.texture = paltex ? m_renderer->m_dev->CreateTexture(tw, th, Get8bitFormat()) : m_renderer->m_dev->CreateTexture(tw, th);
+	e.refcount = 1;
+	e.age = 0;
+
+	return &m_hash_cache.emplace(key, e).first->second;
+}
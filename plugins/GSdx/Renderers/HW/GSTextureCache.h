@@ -96,6 +96,27 @@ public:
 		bool operator()(const PaletteKey &lhs, const PaletteKey &rhs) const;
 	};
 
+	// Sources read from GS memory can share their device texture with any other source of the same content,
+	// wherever it was uploaded. The content is identified by a hash of the GS memory blocks of the texture.
+	struct HashCacheKey {
+		uint64 hash;   // GS memory blocks in texture order
+		uint64 clut;   // hash of the clut if the texture was converted with it, else 0
+		uint64 texa;   // TEXA if the texture was expanded with it, else 0
+		uint32 tex;    // PSM TW TH
+
+		bool operator==(const HashCacheKey& key) const;
+	};
+
+	struct HashCacheKeyHash {
+		std::size_t operator()(const HashCacheKey& key) const;
+	};
+
+	struct HashCacheEntry {
+		GSTexture* texture;
+		uint32 refcount;
+		uint32 age;
+	};
+
 	class Source : public Surface
 	{
 		struct {GSVector4i* rect; uint32 count;} m_write;
@@ -121,6 +142,7 @@ public:
 		// Keep a GSTextureCache::SourceMap::m_map iterator to allow fast erase
 		std::array<uint16, MAX_PAGES> m_erase_it;
 		uint32* m_pages_as_bit;
+		HashCacheEntry* m_from_hash_cache; // m_texture is owned by the hash cache, the source must not write into it
 
 	public:
 		Source(GSRenderer* r, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, uint8* temp, bool dummy_container = false);
@@ -215,6 +237,11 @@ protected:
 	static bool m_wrap_gs_mem;
 	uint8 m_texture_inside_rt_cache_size = 255;
 	std::vector<TexInsideRtCacheEntry> m_texture_inside_rt_cache;
+	bool m_texture_hash;
+	std::unordered_map<HashCacheKey, HashCacheEntry, HashCacheKeyHash> m_hash_cache;
+
+	uint64 HashTexture(const GIFRegTEX0& TEX0);
+	HashCacheEntry* LookupHashCache(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool& hit);
 
 	virtual Source* CreateSource(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, Target* t = NULL, bool half_right = false, int x_offset = 0, int y_offset = 0);
 	virtual Target* CreateTarget(const GIFRegTEX0& TEX0, int w, int h, int type);
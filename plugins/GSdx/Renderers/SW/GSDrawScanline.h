@@ -87,4 +87,8 @@ public:
 #endif
 
 	void PrintStats() {m_ds_map.PrintStats();}
+
+	void PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds) {m_sp_map.Prewarm(sp); m_ds_map.Prewarm(ds);}
+	void GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds) {m_sp_map.GetUsedKeys(sp); m_ds_map.GetUsedKeys(ds);}
+	void ResetCodeKeys() {m_sp_map.ResetUsedKeys(); m_ds_map.ResetUsedKeys();}
 };
@@ -131,6 +131,30 @@ int GSRasterizer::GetPixels(bool reset)
 	return pixels;
 }
 
+void GSRasterizerList::PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds)
+{
+	for(auto& r : m_r)
+	{
+		r->PrewarmCode(sp, ds);
+	}
+}
+
+void GSRasterizerList::GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds)
+{
+	for(auto& r : m_r)
+	{
+		r->GetCodeKeys(sp, ds);
+	}
+}
+
+void GSRasterizerList::ResetCodeKeys()
+{
+	for(auto& r : m_r)
+	{
+		r->ResetCodeKeys();
+	}
+}
+
 void GSRasterizer::Draw(GSRasterizerData* data)
 {
 	GSPerfMonAutoTimer pmat(m_perfmon, GSPerfMon::WorkerDraw0 + m_id);
@@ -106,6 +106,10 @@ public:
 
 	virtual void PrintStats() = 0;
 
+	virtual void PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds) = 0;
+	virtual void GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds) = 0;
+	virtual void ResetCodeKeys() = 0;
+
 	__forceinline bool HasEdge() const {return m_de != NULL;}
 	__forceinline bool IsSolidRect() const {return m_dr != NULL;}
 };
@@ -120,6 +124,12 @@ public:
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
 	virtual void PrintStats() = 0;
+
+	// Selectors of the JIT generated scanline code, see GSRendererSW::LoadCodeKeys.
+	// GetCodeKeys returns the ones drawn with since ResetCodeKeys, both need a Sync first.
+	virtual void PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds) = 0;
+	virtual void GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds) = 0;
+	virtual void ResetCodeKeys() = 0;
 };
 
 class alignas(32) GSRasterizer : public IRasterizer
@@ -176,6 +186,9 @@ public:
 	bool IsSynced() const {return true;}
 	int GetPixels(bool reset);
 	void PrintStats() {m_ds->PrintStats();}
+	void PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds) {m_ds->PrewarmCode(sp, ds);}
+	void GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds) {m_ds->GetCodeKeys(sp, ds);}
+	void ResetCodeKeys() {m_ds->ResetCodeKeys();}
 };
 
 class GSRasterizerList : public IRasterizer
@@ -224,4 +237,7 @@ public:
 	bool IsSynced() const;
 	int GetPixels(bool reset);
 	void PrintStats() {}
+	void PrewarmCode(const std::vector<uint64>& sp, const std::vector<uint64>& ds);
+	void GetCodeKeys(std::vector<uint64>& sp, std::vector<uint64>& ds);
+	void ResetCodeKeys();
 };
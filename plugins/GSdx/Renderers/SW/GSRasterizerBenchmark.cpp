@@ -0,0 +1,545 @@
+/*
+ *	Copyright (C) 2007-2009 Gabest
+ *	http://www.gabest.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with GNU Make; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "stdafx.h"
+#include "GSRasterizerBenchmark.h"
+
+// 640x448 32-bit frame buffer with a 32-bit z-buffer behind it, textures are 256x256 and
+// laid out like GSTextureCacheSW does it (tw = 8, all mipmap levels share the pitch)
+
+static const int s_width = 640;
+static const int s_height = 448;
+static const int s_tw = 8;
+
+GSRasterizerBenchmark::GSRasterizerBenchmark()
+{
+	m_mem = new GSLocalMemory();
+
+	m_scissor = GSVector4i(0, 0, s_width, s_height);
+
+	m_FRAME.u64 = 0;
+	m_FRAME.FBP = 0;
+	m_FRAME.FBW = s_width / 64;
+	m_FRAME.PSM = PSM_PSMCT32;
+
+	m_ZBUF.u64 = 0;
+	m_ZBUF.ZBP = (s_width * s_height * 4) >> 13;
+	m_ZBUF.PSM = PSM_PSMZ32;
+
+	int tw = 1 << s_tw;
+
+	for(size_t i = 0; i < countof(m_tex32); i++)
+	{
+		m_tex32[i] = (uint8*)_aligned_malloc(tw * tw * 4, 32);
+
+		uint32* RESTRICT p = (uint32*)m_tex32[i];
+
+		for(int y = 0; y < tw; y++)
+		{
+			for(int x = 0; x < tw; x++)
+			{
+				p[y * tw + x] = ((x ^ y) & 0xff) * 0x010101 | (uint32)(i * 0x10 + 0x40) << 24;
+			}
+		}
+	}
+
+	m_tex8 = (uint8*)_aligned_malloc(tw * tw, 32);
+
+	for(int i = 0; i < tw * tw; i++)
+	{
+		m_tex8[i] = (uint8)((i >> s_tw) ^ i);
+	}
+
+	m_clut = (uint32*)_aligned_malloc(sizeof(uint32) * 256, 32);
+
+	for(int i = 0; i < 256; i++)
+	{
+		m_clut[i] = i * 0x00030507 | 0x80000000;
+	}
+
+	Workload* w;
+
+	// full screen flat sprites, no test, aligned: handled by DrawRect
+
+	w = CreateWorkload("sprite flood", GS_SPRITE_CLASS);
+
+	for(int n = 0; n < 4; n++)
+	{
+		AddQuad(w, 0, 0, s_width, 0, GSVector4(32 * n, 64, 128, 128), 1, 1);
+	}
+
+	Finish(w);
+
+	// textured sprites (decal, nearest)
+
+	w = CreateWorkload("sprite textured", GS_SPRITE_CLASS);
+
+	SetTexture(w, false, false);
+
+	w->global.sel.tfx = TFX_DECAL;
+
+	for(int y = 0; y < s_height; y += 64)
+	{
+		for(int x = 0; x < s_width; x += 64)
+		{
+			AddQuad(w, x, y, 64, 0, GSVector4(128), 1, 1);
+		}
+	}
+
+	Finish(w);
+
+	// small gouraud shaded triangles
+
+	w = CreateWorkload("small triangles", GS_TRIANGLE_CLASS);
+
+	w->global.sel.iip = 1;
+
+	for(int y = 0; y < s_height; y += 8)
+	{
+		for(int x = 0; x < s_width; x += 8)
+		{
+			AddQuad(w, x, y, 8, 0, GSVector4(x & 0xff, y & 0xff, 128, 128), 1, 1);
+		}
+	}
+
+	Finish(w);
+
+	// two layers of alpha blended bilinear textured sprites (Cs - Cd) * As + Cd
+
+	w = CreateWorkload("alpha blended", GS_SPRITE_CLASS);
+
+	SetTexture(w, false, true);
+
+	w->global.sel.abe = 1;
+	w->global.sel.ababcd = 0x44;
+	w->global.sel.rfb = 1;
+
+	for(int n = 0; n < 2; n++)
+	{
+		for(int y = 0; y < s_height; y += 64)
+		{
+			for(int x = 0; x < s_width; x += 64)
+			{
+				AddQuad(w, x, y, 64, 0, GSVector4(128, 128, 128, 64), 1, 1);
+			}
+		}
+	}
+
+	Finish(w);
+
+	// two layers of z-tested (GEQUAL) and z-written gouraud triangles, the second layer fails half of the time
+
+	w = CreateWorkload("z tested", GS_TRIANGLE_CLASS);
+
+	w->global.sel.iip = 1;
+	w->global.sel.zwrite = 1;
+	w->global.sel.ztest = 1;
+	w->global.sel.zpsm = 0;
+	w->global.sel.ztst = ZTST_GEQUAL;
+
+	for(int n = 0; n < 2; n++)
+	{
+		for(int y = 0; y < s_height; y += 32)
+		{
+			for(int x = 0; x < s_width; x += 32)
+			{
+				AddQuad(w, x, y, 32, 0x100000 + ((x ^ y ^ (n << 5)) & 32) * 0x1000, GSVector4(128, x & 0xff, y & 0xff, 128), 1, 1);
+			}
+		}
+	}
+
+	Finish(w);
+
+	// 8-bit paletted bilinear textured triangles, modulated
+
+	w = CreateWorkload("paletted", GS_TRIANGLE_CLASS);
+
+	SetTexture(w, true, true);
+
+	w->global.sel.iip = 1;
+
+	for(int y = 0; y < s_height; y += 64)
+	{
+		for(int x = 0; x < s_width; x += 64)
+		{
+			AddQuad(w, x, y, 64, 0, GSVector4(96, 128, 160, 128), 1, 1);
+		}
+	}
+
+	Finish(w);
+
+	// perspective correct trilinear mipmapped triangles, q falls from 1 to 1/8 going down each quad (lod 0-3)
+
+	w = CreateWorkload("mipmapped", GS_TRIANGLE_CLASS);
+
+	SetTexture(w, false, true);
+
+	w->global.sel.fst = 0;
+	w->global.sel.mmin = 2;
+	w->global.sel.lcm = 0;
+
+	#if _M_SSE >= 0x501
+	w->global.mxl = GSVector8((float)((6 << 16) - 1));
+	w->global.l = GSVector8((float)-0x10000);
+	w->global.k = GSVector8(0.0f);
+	#else
+	w->global.mxl = GSVector4((float)((6 << 16) - 1));
+	w->global.l = GSVector4((float)-0x10000);
+	w->global.k = GSVector4(0.0f);
+	#endif
+
+	for(int i = 1; i < 7; i++)
+	{
+		w->global.tex[i] = m_tex32[i];
+	}
+
+	for(int y = 0; y < s_height; y += 64)
+	{
+		for(int x = 0; x < s_width; x += 64)
+		{
+			AddQuad(w, x, y, 64, 0, GSVector4(128), 1.0f, 0.125f);
+		}
+	}
+
+	Finish(w);
+}
+
+GSRasterizerBenchmark::~GSRasterizerBenchmark()
+{
+	for(auto w : m_workloads) delete w;
+
+	for(size_t i = 0; i < countof(m_tex32); i++)
+	{
+		_aligned_free(m_tex32[i]);
+	}
+
+	_aligned_free(m_tex8);
+	_aligned_free(m_clut);
+
+	delete m_mem;
+}
+
+GSRasterizerBenchmark::Workload* GSRasterizerBenchmark::CreateWorkload(const char* name, GS_PRIM_CLASS primclass)
+{
+	Workload* w = new Workload();
+
+	w->name = name;
+	w->primclass = primclass;
+
+	GSScanlineGlobalData& gd = w->global;
+
+	memset(&gd, 0, sizeof(gd));
+
+	GSOffset* fb = m_mem->GetOffset(m_FRAME.Block(), m_FRAME.FBW, m_FRAME.PSM);
+	GSOffset* zb = m_mem->GetOffset(m_ZBUF.Block(), m_FRAME.FBW, m_ZBUF.PSM);
+	GSPixelOffset4* fzb4 = m_mem->GetPixelOffset4(m_FRAME, m_ZBUF);
+
+	gd.vm = m_mem->m_vm8;
+
+	gd.fbr = fb->pixel.row;
+	gd.zbr = zb->pixel.row;
+	gd.fbc = fb->pixel.col[0];
+	gd.zbc = zb->pixel.col[0];
+	gd.fzbr = fzb4->row;
+	gd.fzbc = fzb4->col;
+
+	gd.sel.key = 0;
+
+	gd.sel.fpsm = GSLocalMemory::m_psm[m_FRAME.PSM].fmt;
+	gd.sel.zpsm = 3;
+	gd.sel.atst = ATST_ALWAYS;
+	gd.sel.tfx = TFX_NONE;
+	gd.sel.ababcd = 0xff;
+	gd.sel.prim = primclass;
+	gd.sel.fwrite = 1;
+	gd.sel.colclamp = 1;
+
+	m_workloads.push_back(w);
+
+	return w;
+}
+
+void GSRasterizerBenchmark::SetTexture(Workload* w, bool paletted, bool linear)
+{
+	GSScanlineGlobalData& gd = w->global;
+
+	gd.sel.tfx = TFX_MODULATE;
+	gd.sel.tcc = 1;
+	gd.sel.fst = 1;
+	gd.sel.ltf = linear;
+	gd.sel.tw = s_tw - 3;
+	gd.sel.wms = CLAMP_REPEAT;
+	gd.sel.wmt = CLAMP_REPEAT;
+
+	if(paletted)
+	{
+		gd.sel.tlu = 1;
+
+		gd.tex[0] = m_tex8;
+		gd.clut = m_clut;
+	}
+	else
+	{
+		gd.tex[0] = m_tex32[0];
+	}
+
+	uint16 tw = 1u << s_tw;
+
+	gd.t.min.u16[0] = gd.t.minmax.u16[0] = tw - 1;
+	gd.t.max.u16[0] = gd.t.minmax.u16[2] = 0;
+	gd.t.mask.u32[0] = 0xffffffff;
+	gd.t.min.u16[4] = gd.t.minmax.u16[1] = tw - 1;
+	gd.t.max.u16[4] = gd.t.minmax.u16[3] = 0;
+	gd.t.mask.u32[2] = 0xffffffff;
+
+	gd.t.min = gd.t.min.xxxxlh();
+	gd.t.max = gd.t.max.xxxxlh();
+	gd.t.mask = gd.t.mask.xxzz();
+	gd.t.invmask = ~gd.t.mask;
+}
+
+void GSRasterizerBenchmark::AddQuad(Workload* w, int x, int y, int size, uint32 z, const GSVector4& c, float q0, float q1)
+{
+	// same layout as GSRendererSW::ConvertVertexBuffer produces it
+
+	const GSScanlineGlobalData& gd = w->global;
+
+	int tsize = 1 << s_tw;
+
+	GSVector4i xy[4] = {GSVector4i(x, y), GSVector4i(x + size, y), GSVector4i(x, y + size), GSVector4i(x + size, y + size)};
+	GSVector4i uv[4] = {GSVector4i(0, 0), GSVector4i(tsize, 0), GSVector4i(0, tsize), GSVector4i(tsize, tsize)};
+	float q[4] = {q0, q0, q1, q1};
+
+	uint32 base = (uint32)w->vertex.size();
+
+	for(int i = 0; i < 4; i++)
+	{
+		if(w->primclass == GS_SPRITE_CLASS && (i == 1 || i == 2)) continue;
+
+		GSVertexSW v;
+
+		v.p = GSVector4((float)xy[i].x, (float)xy[i].y, (float)z, 0.0f);
+		v.c = c * 128.0f;
+		v.t = GSVector4::zero();
+
+		if(gd.sel.tfx != TFX_NONE)
+		{
+			GSVector4 t = GSVector4(uv[i]) * 65536.0f;
+
+			if(gd.sel.fst)
+			{
+				v.t = t;
+			}
+			else
+			{
+				v.t = GSVector4(t.x * q[i], t.y * q[i], q[i], 0.0f);
+			}
+		}
+
+		if(w->primclass == GS_SPRITE_CLASS)
+		{
+			v.t.u32[3] = z;
+		}
+		else if(gd.sel.iip)
+		{
+			v.c = v.c * GSVector4((float)(i + 1) / 4);
+		}
+
+		w->vertex.push_back(v);
+	}
+
+	if(w->primclass == GS_SPRITE_CLASS)
+	{
+		w->index.push_back(base + 0);
+		w->index.push_back(base + 1);
+	}
+	else
+	{
+		w->index.push_back(base + 0);
+		w->index.push_back(base + 1);
+		w->index.push_back(base + 2);
+		w->index.push_back(base + 1);
+		w->index.push_back(base + 2);
+		w->index.push_back(base + 3);
+	}
+}
+
+void GSRasterizerBenchmark::Finish(Workload* w)
+{
+	GSScanlineGlobalData& gd = w->global;
+
+	GSVector4 pmin = GSVector4(FLT_MAX);
+	GSVector4 pmax = GSVector4(-FLT_MAX);
+
+	for(const auto& v : w->vertex)
+	{
+		pmin = pmin.min(v.p);
+		pmax = pmax.max(v.p);
+	}
+
+	w->bbox = GSVector4i(pmin.floor().xyxy(pmax.ceil()));
+
+	// all quads are aligned to 8 pixels
+
+	if(gd.sel.prim == GS_SPRITE_CLASS && !gd.sel.ftest && !gd.sel.ztest && w->bbox.eq(w->bbox.rintersect(m_scissor)))
+	{
+		gd.sel.notest = 1;
+	}
+
+	uint32 fm = 0;
+	uint32 zm = gd.sel.zwrite ? 0 : 0xffffffff;
+
+	#if _M_SSE >= 0x501
+
+	gd.fm = fm;
+	gd.zm = zm;
+
+	#else
+
+	gd.fm = GSVector4i(fm);
+	gd.zm = GSVector4i(zm);
+
+	#endif
+}
+
+std::shared_ptr<GSRasterizerData> GSRasterizerBenchmark::CreateData(const Workload* w)
+{
+	GSDrawScanline::SharedData* sd = new GSDrawScanline::SharedData();
+
+	std::shared_ptr<GSRasterizerData> data(sd);
+
+	int vertex_count = (int)w->vertex.size();
+	int index_count = (int)w->index.size();
+
+	sd->primclass = w->primclass;
+	sd->buff = (uint8*)_aligned_malloc(sizeof(GSVertexSW) * ((vertex_count + 1) & ~1) + sizeof(uint32) * index_count, 64);
+	sd->vertex = (GSVertexSW*)sd->buff;
+	sd->vertex_count = vertex_count;
+	sd->index = (uint32*)(sd->buff + sizeof(GSVertexSW) * ((vertex_count + 1) & ~1));
+	sd->index_count = index_count;
+
+	memcpy(sd->vertex, w->vertex.data(), sizeof(GSVertexSW) * vertex_count);
+	memcpy(sd->index, w->index.data(), sizeof(uint32) * index_count);
+
+	sd->scissor = m_scissor;
+	sd->bbox = w->bbox;
+	sd->frame = 0;
+
+	memcpy(&sd->global, &w->global, sizeof(sd->global));
+
+	return data;
+}
+
+void GSRasterizerBenchmark::Run(int threads, int duration)
+{
+	std::vector<int> counts;
+
+	for(int i = 0; i <= threads; i = std::max<int>(i * 2, 1))
+	{
+		counts.push_back(i);
+	}
+
+	if(counts.back() != threads)
+	{
+		counts.push_back(threads);
+	}
+
+	std::vector<std::vector<double>> mpps(m_workloads.size());
+
+	for(int n : counts)
+	{
+		IRasterizer* rl = GSRasterizerList::Create<GSDrawScanline>(n, &m_perfmon);
+
+		for(size_t i = 0; i < m_workloads.size(); i++)
+		{
+			const Workload* w = m_workloads[i];
+
+			// the first draw compiles the setup and scanline code, and tells how many pixels
+			// a draw covers (the per-rasterizer counters would overflow over a longer run)
+
+			rl->Queue(CreateData(w));
+			rl->Sync();
+
+			int64 pixels = rl->GetPixels(true);
+			int64 draws = 0;
+
+			// the same data is queued over and over, just like a draw is shared by the workers,
+			// and the queues are drained every 256 draws so Sync never waits for long
+
+			std::shared_ptr<GSRasterizerData> data = CreateData(w);
+
+			auto start = std::chrono::steady_clock::now();
+			auto end = start;
+
+			do
+			{
+				for(int j = 0; j < 16; j++)
+				{
+					rl->Queue(data);
+				}
+
+				draws += 16;
+
+				if((draws & 255) == 0)
+				{
+					rl->Sync();
+				}
+
+				end = std::chrono::steady_clock::now();
+			}
+			while(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() < duration);
+
+			rl->Sync();
+			rl->GetPixels(true);
+
+			end = std::chrono::steady_clock::now();
+
+			double us = (double)std::max<int64>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(), 1);
+
+			mpps[i].push_back((double)(pixels * draws) / us);
+		}
+
+		delete rl;
+	}
+
+	printf("%-16s %-16s", "", "selector");
+
+	for(int n : counts)
+	{
+		printf(" | %2d threads", n);
+	}
+
+	printf("  (Mpixels/s)\n");
+
+	for(size_t i = 0; i < m_workloads.size(); i++)
+	{
+		const Workload* w = m_workloads[i];
+
+		printf("%-16s %016llx", w->name, (unsigned long long)w->global.sel.key);
+
+		for(size_t j = 0; j < counts.size(); j++)
+		{
+			printf(" | %10.1f", mpps[i][j]);
+		}
+
+		printf("\n");
+	}
+}
@@ -0,0 +1,65 @@
+/*
+ *	Copyright (C) 2007-2009 Gabest
+ *	http://www.gabest.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with GNU Make; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#pragma once
+
+#include "Renderers/SW/GSDrawScanline.h"
+#include "Renderers/SW/GSRasterizer.h"
+
+// Feeds synthetic draws straight into GSRasterizerList and the generated scanline code,
+// no GS state, texture cache or window is involved. Reports the fill rate of each workload
+// (and its scanline selector) for a range of worker thread counts.
+
+class GSRasterizerBenchmark
+{
+	struct Workload
+	{
+		const char* name;
+		GSScanlineGlobalData global;
+		GS_PRIM_CLASS primclass;
+		std::vector<GSVertexSW> vertex;
+		std::vector<uint32> index;
+		GSVector4i bbox;
+	};
+
+	GSLocalMemory* m_mem;
+	GSPerfMon m_perfmon;
+	GSVector4i m_scissor;
+	GIFRegFRAME m_FRAME;
+	GIFRegZBUF m_ZBUF;
+	uint8* m_tex32[7];
+	uint8* m_tex8;
+	uint32* m_clut;
+	std::vector<Workload*> m_workloads;
+
+	Workload* CreateWorkload(const char* name, GS_PRIM_CLASS primclass);
+	void AddQuad(Workload* w, int x, int y, int size, uint32 z, const GSVector4& c, float q0, float q1);
+	void SetTexture(Workload* w, bool paletted, bool linear);
+	void Finish(Workload* w);
+
+	std::shared_ptr<GSRasterizerData> CreateData(const Workload* w);
+
+public:
+	GSRasterizerBenchmark();
+	virtual ~GSRasterizerBenchmark();
+
+	void Run(int threads, int duration);
+};
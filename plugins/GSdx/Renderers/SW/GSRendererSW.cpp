@@ -41,7 +41,9 @@ void GSRendererSW::InitVectors()
 }
 
 GSRendererSW::GSRendererSW(int threads)
-	: m_fzb(NULL)
+	: m_cvbt_buff(NULL)
+	, m_fzb(NULL)
+	, m_pages_waiting(false)
 {
 	m_nativeres = true; // ignore ini, sw is always native
 
@@ -60,6 +62,12 @@ GSRendererSW::GSRendererSW(int threads)
 		m_tex_pages[i] = 0;
 	}
 
+	memset(m_sync_fzb_pages, 0, sizeof(m_sync_fzb_pages));
+	memset(m_sync_tex_pages, 0, sizeof(m_sync_tex_pages));
+	memset(m_sync_stats, 0, sizeof(m_sync_stats));
+	m_sync_stats_frames = 0;
+	m_sync_stats_log = theApp.GetConfigB("debug_sw_sync");
+
 	#define InitCVB2(P, Q) \
 		m_cvb[P][0][0][Q] = &GSRendererSW::ConvertVertexBuffer<P, 0, 0, Q>; \
 		m_cvb[P][0][1][Q] = &GSRendererSW::ConvertVertexBuffer<P, 0, 1, Q>; \
@@ -75,6 +83,43 @@ GSRendererSW::GSRendererSW(int threads)
 	InitCVB(GS_TRIANGLE_CLASS);
 	InitCVB(GS_SPRITE_CLASS);
 
+	#if _M_SSE >= 0x401
+
+	#define InitCVBT3(P, IIP, TME, FST) \
+		m_cvbt[P][IIP][TME][FST][0][0] = &GSRendererSW::ConvertVertexBufferTrace<P, IIP, TME, FST, 0, 0>; \
+		m_cvbt[P][IIP][TME][FST][0][1] = &GSRendererSW::ConvertVertexBufferTrace<P, IIP, TME, FST, 0, 1>; \
+		m_cvbt[P][IIP][TME][FST][1][0] = &GSRendererSW::ConvertVertexBufferTrace<P, IIP, TME, FST, 1, 0>; \
+		m_cvbt[P][IIP][TME][FST][1][1] = &GSRendererSW::ConvertVertexBufferTrace<P, IIP, TME, FST, 1, 1>;
+
+	#define InitCVBT2(P, IIP) \
+		InitCVBT3(P, IIP, 0, 0) \
+		InitCVBT3(P, IIP, 0, 1) \
+		InitCVBT3(P, IIP, 1, 0) \
+		InitCVBT3(P, IIP, 1, 1)
+
+	#define InitCVBT(P) \
+		InitCVBT2(P, 0) \
+		InitCVBT2(P, 1)
+
+	InitCVBT(GS_POINT_CLASS);
+	InitCVBT(GS_LINE_CLASS);
+	InitCVBT(GS_TRIANGLE_CLASS);
+	InitCVBT(GS_SPRITE_CLASS);
+
+	#else
+
+	memset(m_cvbt, 0, sizeof(m_cvbt));
+
+	#endif
+
+	for(int i = 0; i < threads; i++)
+	{
+		m_cvbt_workers.push_back(std::unique_ptr<ConvertVertexBufferTraceWorker>(new ConvertVertexBufferTraceWorker(
+			[this](ConvertVertexBufferTraceJob* &job) { (this->*job->fn)(*job); })));
+	}
+
+	m_cvbt_jobs.resize(m_cvbt_workers.size() + 1);
+
 	m_dump_root = root_sw;
 
 	// Reset handler with the auto flush hack enabled on the SW renderer.
@@ -87,8 +132,14 @@ GSRendererSW::GSRendererSW(int threads)
 
 GSRendererSW::~GSRendererSW()
 {
+	m_rl->Sync();
+
+	SaveCodeKeys();
+
 	delete m_tc;
 
+	if(m_cvbt_buff != NULL) _aligned_free(m_cvbt_buff);
+
 	for(size_t i = 0; i < countof(m_texture); i++)
 	{
 		delete m_texture[i];
@@ -145,6 +196,30 @@ void GSRendererSW::VSync(int field)
 	//
 	*/
 
+	// per reason full / page syncs over the same 32 frames as the perfmon stats
+
+	if(m_sync_stats_log && ++m_sync_stats_frames == 32)
+	{
+		std::string s;
+
+		for(size_t i = 0; i < countof(m_sync_stats[0]); i++)
+		{
+			if(m_sync_stats[0][i] || m_sync_stats[1][i])
+			{
+				s += format(" %d:%u/%u", (int)i - 1, m_sync_stats[0][i], m_sync_stats[1][i]);
+			}
+		}
+
+		if(!s.empty())
+		{
+			printf("GSdx: SW sync full/pages by reason (32 frames):%s\n", s.c_str());
+		}
+
+		memset(m_sync_stats, 0, sizeof(m_sync_stats));
+
+		m_sync_stats_frames = 0;
+	}
+
 	GSRenderer::VSync(field);
 
 	m_tc->IncAge();
@@ -152,6 +227,102 @@ void GSRendererSW::VSync(int field)
 	// if((m_perfmon.GetFrame() & 255) == 0) m_rl->PrintStats();
 }
 
+void GSRendererSW::SetGameCRC(uint32 crc, int options)
+{
+	if(crc != m_crc)
+	{
+		// the code maps of the rasterizers are read and reset below
+
+		m_rl->Sync();
+
+		SaveCodeKeys();
+
+		m_rl->ResetCodeKeys();
+
+		GSRenderer::SetGameCRC(crc, options);
+
+		LoadCodeKeys();
+	}
+	else
+	{
+		GSRenderer::SetGameCRC(crc, options);
+	}
+}
+
+// The selectors of the scanline code generated for a game are remembered across runs, so
+// that the code can be generated in the background as soon as the game is recognized,
+// instead of stalling the draw that first needs it.
+
+std::string GSRendererSW::GetCodeKeysPath() const
+{
+	return theApp.GetConfigDir() + format("GSdx_sw_%08X.jit", m_crc);
+}
+
+void GSRendererSW::LoadCodeKeys()
+{
+	std::vector<uint64>& sp = m_code_keys_sp;
+	std::vector<uint64>& ds = m_code_keys_ds;
+
+	sp.clear();
+	ds.clear();
+
+	if(m_crc == 0 || GLLoader::in_replayer)
+	{
+		return;
+	}
+
+	if(FILE* fp = fopen(GetCodeKeysPath().c_str(), "r"))
+	{
+		char type[3];
+		unsigned long long key;
+
+		while(fscanf(fp, "%2s %llx", type, &key) == 2)
+		{
+			if(!strcmp(type, "sp")) sp.push_back(key);
+			else if(!strcmp(type, "ds")) ds.push_back(key);
+		}
+
+		fclose(fp);
+	}
+
+	if(!sp.empty() || !ds.empty())
+	{
+		m_rl->PrewarmCode(sp, ds);
+	}
+}
+
+void GSRendererSW::SaveCodeKeys()
+{
+	if(m_crc == 0 || GLLoader::in_replayer)
+	{
+		return;
+	}
+
+	// Only the code drawn with since the game was set (code generated for an earlier game of the
+	// session stays in the code maps), plus the keys of the previous runs that weren't used again.
+
+	std::vector<uint64> sp(m_code_keys_sp), ds(m_code_keys_ds);
+
+	m_rl->GetCodeKeys(sp, ds);
+
+	if(sp.empty() && ds.empty())
+	{
+		return;
+	}
+
+	// Every rasterizer thread generates its own copy of the code.
+
+	std::set<uint64> sp_set(sp.begin(), sp.end()), ds_set(ds.begin(), ds.end());
+
+	if(FILE* fp = fopen(GetCodeKeysPath().c_str(), "w"))
+	{
+		for(uint64 key : sp_set) fprintf(fp, "sp %016llx\n", (unsigned long long)key);
+		for(uint64 key : ds_set) fprintf(fp, "ds %016llx\n", (unsigned long long)key);
+
+		fclose(fp);
+	}
+}
+
 void GSRendererSW::ResetDevice()
 {
 	for(size_t i = 0; i < countof(m_texture); i++)
@@ -384,6 +555,255 @@ void GSRendererSW::ConvertVertexBuffer(GSVertexSW* RESTRICT dst, const GSVertex*
 	#endif
 }
 
+template<uint32 primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
+void GSRendererSW::ConvertVertexBufferTrace(ConvertVertexBufferTraceJob& job)
+{
+	#if _M_SSE >= 0x401
+
+	GSVector4i off = (GSVector4i)m_context->XYOFFSET;
+	GSVector4 tsize = GSVector4(0x10000 << m_context->TEX0.TW, 0x10000 << m_context->TEX0.TH, 1, 0);
+	GSVector4i z_max = GSVector4i::xffffffff().srl32(GSLocalMemory::m_psm[m_context->ZBUF.PSM].fmt * 8);
+
+	// same as ConvertVertexBuffer<primclass, tme, fst, 0>
+
+	auto convert = [&](GSVertexSW* RESTRICT dst, const GSVector4i& c, GSVector4i xyzuvf)
+	{
+		GSVector4 stcq = GSVector4::cast(c); // s t rgba q
+
+		GSVector4i xy = xyzuvf.upl16() - off;
+		GSVector4i zf = xyzuvf.ywww().min_u32(GSVector4i::xffffff00());
+
+		dst->p = GSVector4(xy).xyxy(GSVector4(zf) + (GSVector4::m_x4f800000 & GSVector4::cast(zf.sra32(31)))) * m_pos_scale;
+		dst->c = GSVector4(c.zzzz().u8to32() << 7);
+
+		GSVector4 t = GSVector4::zero();
+
+		if(tme)
+		{
+			if(fst)
+			{
+				t = GSVector4(xyzuvf.uph16() << (16 - 4));
+			}
+			else
+			{
+				t = stcq.xyww() * tsize;
+			}
+		}
+
+		if(primclass == GS_SPRITE_CLASS)
+		{
+			xyzuvf = xyzuvf.min_u32(z_max);
+			t = t.insert32<1, 3>(GSVector4::cast(xyzuvf));
+		}
+
+		dst->t = t;
+	};
+
+	// same as GSVertexTrace::FindMinMax, every vertex below m_vertex.next is referenced by the index buffer,
+	// visiting them in order instead of through the indices gives the same ranges
+
+	job.mm.Init();
+
+	GSVector4 tmin = job.mm.tmin;
+	GSVector4 tmax = job.mm.tmax;
+	GSVector4i cmin = job.mm.cmin;
+	GSVector4i cmax = job.mm.cmax;
+	GSVector4i pmin = job.mm.pmin;
+	GSVector4i pmax = job.mm.pmax;
+
+	const int n = primclass == GS_SPRITE_CLASS ? 2 : 1;
+
+	const GSVertex* RESTRICT src = job.src;
+	GSVertexSW* RESTRICT dst = job.dst;
+
+	for(int i = job.count; i > 0; i -= n, src += n, dst += n)
+	{
+		if(primclass == GS_SPRITE_CLASS)
+		{
+			GSVector4i c0(src[0].m[0]);
+			GSVector4i c1(src[1].m[0]);
+			GSVector4i xyzf0(src[0].m[1]);
+			GSVector4i xyzf1(src[1].m[1]);
+
+			if(color)
+			{
+				if(iip)
+				{
+					cmin = cmin.min_u8(c0.min_u8(c1));
+					cmax = cmax.max_u8(c0.max_u8(c1));
+				}
+				else
+				{
+					cmin = cmin.min_u8(c1);
+					cmax = cmax.max_u8(c1);
+				}
+			}
+
+			if(tme)
+			{
+				if(!fst)
+				{
+					GSVector4 stq0 = GSVector4::cast(c0);
+					GSVector4 stq1 = GSVector4::cast(c1);
+
+					if(accurate_stq)
+					{
+						GSVector4 q = stq1.wwww();
+
+						stq0 = (stq0.xyww() / q).xyww(stq1);
+						stq1 = (stq1.xyww() / q).xyww(stq1);
+					}
+					else
+					{
+						GSVector4 q = stq1.wwww().rcpnr();
+
+						stq0 = (stq0.xyww() * q).xyww(stq1);
+						stq1 = (stq1.xyww() * q).xyww(stq1);
+					}
+
+					tmin = tmin.min(stq0.min(stq1));
+					tmax = tmax.max(stq0.max(stq1));
+				}
+				else
+				{
+					GSVector4 st0 = GSVector4(xyzf0.uph16()).xyxy();
+					GSVector4 st1 = GSVector4(xyzf1.uph16()).xyxy();
+
+					tmin = tmin.min(st0.min(st1));
+					tmax = tmax.max(st0.max(st1));
+				}
+			}
+
+			GSVector4i p0 = xyzf0.upl16().blend16<0xf0>(xyzf0.yyyy().uph32(xyzf1));
+			GSVector4i p1 = xyzf1.upl16().blend16<0xf0>(xyzf1.yyyy().uph32(xyzf1));
+
+			pmin = pmin.min_u32(p0.min_u32(p1));
+			pmax = pmax.max_u32(p0.max_u32(p1));
+
+			convert(&dst[0], c0, xyzf0);
+			convert(&dst[1], c1, xyzf1);
+		}
+		else
+		{
+			// flat shaded lines and triangles are not handled here, only the last vertex of the primitive counts for them
+
+			GSVector4i c(src->m[0]);
+			GSVector4i xyzf(src->m[1]);
+
+			if(color)
+			{
+				cmin = cmin.min_u8(c);
+				cmax = cmax.max_u8(c);
+			}
+
+			if(tme)
+			{
+				if(!fst)
+				{
+					GSVector4 stq = GSVector4::cast(c);
+
+					GSVector4 q = stq.wwww();
+
+					if(accurate_stq)
+						stq = (stq.xyww() / q).xyww(q);
+					else
+						stq = (stq.xyww() * q.rcpnr()).xyww(q);
+
+					tmin = tmin.min(stq);
+					tmax = tmax.max(stq);
+				}
+				else
+				{
+					GSVector4 st = GSVector4(xyzf.uph16()).xyxy();
+
+					tmin = tmin.min(st);
+					tmax = tmax.max(st);
+				}
+			}
+
+			GSVector4i p = xyzf.upl16().blend16<0xf0>(xyzf.yyyy().uph32(xyzf));
+
+			pmin = pmin.min_u32(p);
+			pmax = pmax.max_u32(p);
+
+			convert(dst, c, xyzf);
+		}
+	}
+
+	job.mm.tmin = tmin;
+	job.mm.tmax = tmax;
+	job.mm.cmin = cmin;
+	job.mm.cmax = cmax;
+	job.mm.pmin = pmin;
+	job.mm.pmax = pmax;
+
+	#endif
+}
+
+void GSRendererSW::UpdateVertexTrace(GS_PRIM_CLASS primclass)
+{
+	#if _M_SSE >= 0x401
+
+	// Fans may leave unreferenced vertices behind (see VertexKick), those would widen the ranges.
+
+	uint32 iip = PRIM->IIP;
+	uint32 color = m_vt.IsColorTraced();
+
+	if(PRIM->PRIM != GS_TRIANGLEFAN && m_vertex.next > 0 && (!color || iip || primclass == GS_POINT_CLASS || primclass == GS_SPRITE_CLASS))
+	{
+		ASSERT(m_cvbt_buff == NULL);
+
+		int count = (int)m_vertex.next;
+
+		m_cvbt_buff = (uint8*)_aligned_malloc(sizeof(GSVertexSW) * ((count + 1) & ~1) + sizeof(uint32) * m_index.tail, 64);
+
+		ConvertVertexBufferTracePtr fn = m_cvbt[primclass][iip][PRIM->TME][PRIM->FST][color][m_vt.m_accurate_stq];
+
+		// small draws are not worth waking up the workers
+
+		const int min_chunk = 16384;
+
+		int chunks = std::max<int>(std::min<int>(m_cvbt_jobs.size(), count / min_chunk), 1);
+		int step = ((count + chunks - 1) / chunks + 1) & ~1; // sprites must not be split
+
+		for(int i = 0; i < chunks; i++)
+		{
+			ConvertVertexBufferTraceJob& job = m_cvbt_jobs[i];
+
+			int start = i * step;
+
+			job.fn = fn;
+			job.dst = (GSVertexSW*)m_cvbt_buff + start;
+			job.src = m_vertex.buff + start;
+			job.count = std::min<int>(step, count - start);
+		}
+
+		for(int i = 1; i < chunks; i++)
+		{
+			m_cvbt_workers[i - 1]->Push(&m_cvbt_jobs[i]);
+		}
+
+		(this->*fn)(m_cvbt_jobs[0]);
+
+		GSVertexTrace::MinMax& mm = m_cvbt_jobs[0].mm;
+
+		for(int i = 1; i < chunks; i++)
+		{
+			m_cvbt_workers[i - 1]->Wait();
+
+			mm.Merge(m_cvbt_jobs[i].mm);
+		}
+
+		m_vt.Update(mm, m_vertex.buff, m_index.buff, m_vertex.tail, m_index.tail, primclass);
+
+		return;
+	}
+
+	#endif
+
+	GSRenderer::UpdateVertexTrace(primclass);
+}
+
 void GSRendererSW::Draw()
 {
 	const GSDrawingContext* context = m_context;
@@ -393,7 +813,7 @@ void GSRendererSW::Draw()
 	std::shared_ptr<GSRasterizerData> data(sd);
 
 	sd->primclass = m_vt.m_primclass;
-	sd->buff = (uint8*)_aligned_malloc(sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1) + sizeof(uint32) * m_index.tail, 64);
+	sd->buff = m_cvbt_buff != NULL ? m_cvbt_buff : (uint8*)_aligned_malloc(sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1) + sizeof(uint32) * m_index.tail, 64);
 	sd->vertex = (GSVertexSW*)sd->buff;
 	sd->vertex_count = m_vertex.next;
 	sd->index = (uint32*)(sd->buff + sizeof(GSVertexSW) * ((m_vertex.next + 1) & ~1));
@@ -404,7 +824,14 @@ void GSRendererSW::Draw()
 	// If you have both GS_SPRITE_CLASS && m_vt.m_eq.q, it will depends on the first part of the 'OR'
 	uint32 q_div = !IsMipMapActive() && ((m_vt.m_eq.q && m_vt.m_min.t.z != 1.0f) || (!m_vt.m_eq.q && m_vt.m_primclass == GS_SPRITE_CLASS));
 
-	(this->*m_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div])(sd->vertex, m_vertex.buff, m_vertex.next);
+	// UpdateVertexTrace has already converted the vertices without the division
+
+	if(m_cvbt_buff == NULL || q_div)
+	{
+		(this->*m_cvb[m_vt.m_primclass][PRIM->TME][PRIM->FST][q_div])(sd->vertex, m_vertex.buff, m_vertex.next);
+	}
+
+	m_cvbt_buff = NULL;
 
 	memcpy(sd->index, m_index.buff, sizeof(uint32) * m_index.tail);
 
@@ -473,16 +900,30 @@ void GSRendererSW::Draw()
 
 	// check if there is an overlap between this and previous targets
 
+	int reason = -1;
+
 	if(CheckTargetPages(fb_pages, zb_pages, r))
 	{
-		sd->m_syncpoint = SharedData::SyncTarget;
+		reason = 5;
 	}
 
 	// check if the texture is not part of a target currently in use
 
 	if(CheckSourcePages(sd))
 	{
-		sd->m_syncpoint = SharedData::SyncSource;
+		reason = 4;
+	}
+
+	// wait for the queued draws using the conflicting pages, this must happen before our own pages are added
+
+	if(reason >= 0)
+	{
+		SyncPages(reason);
+	}
+	else
+	{
+		memset(m_sync_fzb_pages, 0, sizeof(m_sync_fzb_pages));
+		memset(m_sync_tex_pages, 0, sizeof(m_sync_tex_pages));
 	}
 
 	// addref source and target pages
@@ -592,20 +1033,10 @@ void GSRendererSW::Queue(std::shared_ptr<GSRasterizerData>& item)
 {
 	SharedData* sd = (SharedData*)item.get();
 
-	if(sd->m_syncpoint == SharedData::SyncSource) 
-	{
-		Sync(4);
-	}
-
 	// update previously invalidated parts
 
 	sd->UpdateSource();
 
-	if(sd->m_syncpoint == SharedData::SyncTarget)
-	{
-		Sync(5);
-	}
-
 	if(LOG)
 	{
 		GSScanlineGlobalData& gd = ((SharedData*)item.get())->global;
@@ -643,6 +1074,13 @@ void GSRendererSW::Sync(int reason)
 
 	GSPerfMonAutoTimer pmat(&m_perfmon, GSPerfMon::Sync);
 
+	if(!m_rl->IsSynced())
+	{
+		m_sync_stats[0][reason + 1]++;
+
+		m_perfmon.Put(GSPerfMon::SyncFull, 1);
+	}
+
 	uint64 t = __rdtsc();
 
 	m_rl->Sync();
@@ -675,6 +1113,64 @@ void GSRendererSW::Sync(int reason)
 	m_perfmon.Put(GSPerfMon::Fillrate, pixels);
 }
 
+void GSRendererSW::SyncPages(int reason)
+{
+	GSPerfMonAutoTimer pmat(&m_perfmon, GSPerfMon::Sync);
+
+	uint64 t = __rdtsc();
+
+	// the workers release their pages when a draw is done and only notify if someone is waiting,
+	// m_pages_waiting is set before checking the counters so the last release cannot be missed
+
+	{
+		std::unique_lock<std::mutex> l(m_pages_lock);
+
+		m_pages_waiting = true;
+
+		while(true)
+		{
+			uint32 busy = 0;
+
+			for(int row = 0; row < 16; row++)
+			{
+				for(uint32 mask = m_sync_fzb_pages[row]; mask != 0; mask &= mask - 1)
+				{
+					unsigned long i;
+
+					_BitScanForward(&i, mask);
+
+					if(m_fzb_pages[(row << 5) + i] == 0) m_sync_fzb_pages[row] &= ~(1u << i);
+				}
+
+				for(uint32 mask = m_sync_tex_pages[row]; mask != 0; mask &= mask - 1)
+				{
+					unsigned long i;
+
+					_BitScanForward(&i, mask);
+
+					if(m_tex_pages[(row << 5) + i] == 0) m_sync_tex_pages[row] &= ~(1u << i);
+				}
+
+				busy |= m_sync_fzb_pages[row] | m_sync_tex_pages[row];
+			}
+
+			if(busy == 0) break;
+
+			m_pages_released.wait(l);
+		}
+
+		m_pages_waiting = false;
+	}
+
+	t = __rdtsc() - t;
+
+	if(LOG) {fprintf(s_fp, "sync pages n=%d r=%d t=%llu\n", s_n, reason, t); fflush(s_fp);}
+
+	m_sync_stats[1][reason + 1]++;
+
+	m_perfmon.Put(GSPerfMon::SyncPage, 1);
+}
+
 void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r)
 {
 	if(LOG) {fprintf(s_fp, "w %05x %u %u, %d %d %d %d\n", BITBLTBUF.DBP, BITBLTBUF.DBW, BITBLTBUF.DPSM, r.x, r.y, r.z, r.w); fflush(s_fp);}
@@ -687,14 +1183,20 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 	if(!m_rl->IsSynced())
 	{
+		bool used = false;
+
 		for(uint32* RESTRICT p = m_tmp_pages; *p != GSOffset::EOP; p++)
 		{
-			if(m_fzb_pages[*p] | m_tex_pages[*p])
-			{
-				Sync(6);
+			uint32 row = *p >> 5;
+			uint32 col = 1 << (*p & 31);
 
-				break;
-			}
+			if(m_fzb_pages[*p]) {m_sync_fzb_pages[row] |= col; used = true;}
+			if(m_tex_pages[*p]) {m_sync_tex_pages[row] |= col; used = true;}
+		}
+
+		if(used)
+		{
+			SyncPages(6);
 		}
 	}
 
@@ -711,15 +1213,22 @@ void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 		off->GetPages(r, m_tmp_pages);
 
+		bool used = false;
+
 		for(uint32* RESTRICT p = m_tmp_pages; *p != GSOffset::EOP; p++)
 		{
 			if(m_fzb_pages[*p])
 			{
-				Sync(7);
+				m_sync_fzb_pages[*p >> 5] |= 1 << (*p & 31);
 
-				break;
+				used = true;
 			}
 		}
+
+		if(used)
+		{
+			SyncPages(7);
+		}
 	}
 }
 
@@ -797,8 +1306,8 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 
 			m_fzb_cur_pages[row] |= col;
 
-			used |= m_fzb_pages[i];
-			used |= m_tex_pages[i];
+			if(m_fzb_pages[i]) {m_sync_fzb_pages[row] |= col; used = 1;}
+			if(m_tex_pages[i]) {m_sync_tex_pages[row] |= col; used = 1;}
 		}
 
 		for(const uint32* p = zb_pages; *p != GSOffset::EOP; p++)
@@ -810,8 +1319,8 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 
 			m_fzb_cur_pages[row] |= col;
 
-			used |= m_fzb_pages[i];
-			used |= m_tex_pages[i];
+			if(m_fzb_pages[i]) {m_sync_fzb_pages[row] |= col; used = 1;}
+			if(m_tex_pages[i]) {m_sync_tex_pages[row] |= col; used = 1;}
 		}
 
 		if(!synced)
@@ -856,7 +1365,10 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 				{
 					m_fzb_cur_pages[row] |= col;
 
-					used |= m_fzb_pages[i];
+					// readers of queued draws too, the previous target may not have been fully drained
+
+					if(m_fzb_pages[i]) {m_sync_fzb_pages[row] |= col; used = 1;}
+					if(m_tex_pages[i]) {m_sync_tex_pages[row] |= col; used = 1;}
 				}
 			}
 
@@ -871,7 +1383,10 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 				{
 					m_fzb_cur_pages[row] |= col;
 
-					used |= m_fzb_pages[i];
+					// readers of queued draws too, the previous target may not have been fully drained
+
+					if(m_fzb_pages[i]) {m_sync_fzb_pages[row] |= col; used = 1;}
+					if(m_tex_pages[i]) {m_sync_tex_pages[row] |= col; used = 1;}
 				}
 			}
 
@@ -891,32 +1406,32 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 			// chross-check frame and z-buffer pages, they cannot overlap with eachother and with previous batches in queue,
 			// have to be careful when the two buffers are mutually enabled/disabled and alternating (Bully FBP/ZBP = 0x2300)
 
-			if(fb && !res)
+			if(fb)
 			{
 				for(const uint32* p = fb_pages; *p != GSOffset::EOP; p++)
 				{
 					if(m_fzb_pages[*p] & 0xffff0000)
 					{
-						if(LOG) {fprintf(s_fp, "syncpoint 2\n"); fflush(s_fp);}
+						if(LOG && !res) {fprintf(s_fp, "syncpoint 2\n"); fflush(s_fp);}
 
-						res = true;
+						m_sync_fzb_pages[*p >> 5] |= 1 << (*p & 31);
 
-						break;
+						res = true;
 					}
 				}
 			}
 
-			if(zb && !res)
+			if(zb)
 			{
 				for(const uint32* p = zb_pages; *p != GSOffset::EOP; p++)
 				{
 					if(m_fzb_pages[*p] & 0x0000ffff)
 					{
-						if(LOG) {fprintf(s_fp, "syncpoint 3\n"); fflush(s_fp);}
+						if(LOG && !res) {fprintf(s_fp, "syncpoint 3\n"); fflush(s_fp);}
 
-						res = true;
+						m_sync_fzb_pages[*p >> 5] |= 1 << (*p & 31);
 
-						break;
+						res = true;
 					}
 				}
 			}
@@ -931,6 +1446,8 @@ bool GSRendererSW::CheckTargetPages(const uint32* fb_pages, const uint32* zb_pag
 
 bool GSRendererSW::CheckSourcePages(SharedData* sd)
 {
+	bool res = false;
+
 	if(!m_rl->IsSynced())
 	{
 		for(size_t i = 0; sd->m_tex[i].t != NULL; i++)
@@ -945,13 +1462,15 @@ bool GSRendererSW::CheckSourcePages(SharedData* sd)
 
 				if(m_fzb_pages[*p]) // currently being drawn to? => sync
 				{
-					return true;
+					m_sync_fzb_pages[*p >> 5] |= 1 << (*p & 31);
+
+					res = true;
 				}
 			}
 		}
 	}
 
-	return false;
+	return res;
 }
 
 #include "GSTextureSW.h"
@@ -1431,7 +1950,6 @@ GSRendererSW::SharedData::SharedData(GSRendererSW* parent)
 	, m_fpsm(0)
 	, m_zpsm(0)
 	, m_using_pages(false)
-	, m_syncpoint(SyncNone)
 {
 	m_tex[0].t = NULL;
 
@@ -1520,6 +2038,13 @@ void GSRendererSW::SharedData::ReleasePages()
 	m_zb_pages = NULL;
 
 	m_using_pages = false;
+
+	if(m_parent->m_pages_waiting)
+	{
+		std::lock_guard<std::mutex> l(m_parent->m_pages_lock);
+
+		m_parent->m_pages_released.notify_one();
+	}
 }
 
 void GSRendererSW::SharedData::SetSource(GSTextureCacheSW::Texture* t, const GSVector4i& r, int level)
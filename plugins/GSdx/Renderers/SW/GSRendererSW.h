@@ -47,7 +47,6 @@ class GSRendererSW : public GSRenderer
 		int m_zpsm;
 		bool m_using_pages;
 		TextureLevel m_tex[7 + 1]; // NULL terminated
-		enum {SyncNone, SyncSource, SyncTarget} m_syncpoint;
 
 	public:
 		SharedData(GSRendererSW* parent);
@@ -67,6 +66,32 @@ class GSRendererSW : public GSRenderer
 	template<uint32 primclass, uint32 tme, uint32 fst, uint32 q_div>
 	void ConvertVertexBuffer(GSVertexSW* RESTRICT dst, const GSVertex* RESTRICT src, size_t count);
 
+	// ConvertVertexBuffer and GSVertexTrace::FindMinMax fused into one pass over the vertices (q_div = 0),
+	// large draws are split into chunks and converted by m_cvbt_workers in parallel
+
+	struct ConvertVertexBufferTraceJob;
+
+	typedef void (GSRendererSW::*ConvertVertexBufferTracePtr)(ConvertVertexBufferTraceJob& job);
+
+	struct ConvertVertexBufferTraceJob
+	{
+		GSVertexTrace::MinMax mm;
+		ConvertVertexBufferTracePtr fn;
+		GSVertexSW* dst;
+		const GSVertex* src;
+		int count;
+	};
+
+	typedef GSJobQueue<ConvertVertexBufferTraceJob*, 16> ConvertVertexBufferTraceWorker;
+
+	ConvertVertexBufferTracePtr m_cvbt[4][2][2][2][2][2];
+	std::vector<std::unique_ptr<ConvertVertexBufferTraceWorker>> m_cvbt_workers;
+	std::vector<ConvertVertexBufferTraceJob> m_cvbt_jobs;
+	uint8* m_cvbt_buff; // converted vertices for the next Draw, NULL if UpdateVertexTrace did not convert them
+
+	template<uint32 primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
+	void ConvertVertexBufferTrace(ConvertVertexBufferTraceJob& job);
+
 protected:
 	IRasterizer* m_rl;
 	GSTextureCacheSW* m_tc;
@@ -79,15 +104,30 @@ protected:
 	std::atomic<uint16> m_tex_pages[512];
 	uint32 m_tmp_pages[512 + 1];
 
+	// instead of draining the whole rasterizer queue, conflicts only wait for the queued draws using these pages
+	// (same bit layout as m_fzb_cur_pages, checked against m_fzb_pages and m_tex_pages respectively)
+
+	uint32 m_sync_fzb_pages[16];
+	uint32 m_sync_tex_pages[16];
+	std::mutex m_pages_lock;
+	std::condition_variable m_pages_released;
+	std::atomic<bool> m_pages_waiting;
+	uint32 m_sync_stats[2][9]; // full / page syncs by reason + 1, since the last debug_sw_sync report
+	int m_sync_stats_frames;
+	bool m_sync_stats_log;
+	std::vector<uint64> m_code_keys_sp, m_code_keys_ds; // loaded for the current game
+
 	void Reset();
 	void VSync(int field);
 	void ResetDevice();
 	GSTexture* GetOutput(int i, int& y_offset);
 	GSTexture* GetFeedbackOutput();
 
+	void UpdateVertexTrace(GS_PRIM_CLASS primclass);
 	void Draw();
 	void Queue(std::shared_ptr<GSRasterizerData>& item);
 	void Sync(int reason);
+	void SyncPages(int reason);
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r);
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false);
 
@@ -99,6 +139,12 @@ protected:
 
 	bool GetScanlineGlobalData(SharedData* data);
 
+	std::string GetCodeKeysPath() const;
+	void LoadCodeKeys();
+	void SaveCodeKeys();
+
+	void SetGameCRC(uint32 crc, int options);
+
 public:
 	static void InitVectors();
 
@@ -25,6 +25,9 @@
 GSTextureCacheSW::GSTextureCacheSW(GSState* state)
 	: m_state(state)
 {
+	// Invalidated blocks are hashed before they are converted again, the conversion is skipped if the
+	// data did not change. Helps games which upload the same textures every frame.
+	m_hash = theApp.GetConfigB("texture_hash_sw");
 }
 
 GSTextureCacheSW::~GSTextureCacheSW()
@@ -64,7 +67,7 @@ GSTextureCacheSW::Texture* GSTextureCacheSW::Lookup(const GIFRegTEX0& TEX0, cons
 	}
 
 	// Lookup miss
-	Texture* t = new Texture(m_state, tw0, TEX0, TEXA);
+	Texture* t = new Texture(m_state, tw0, TEX0, TEXA, m_hash);
 
 	m_textures.insert(t);
 
@@ -146,9 +149,10 @@ void GSTextureCacheSW::IncAge()
 
 //
 
-GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
+GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool hash)
 	: m_state(state)
 	, m_buff(NULL)
+	, m_hash(NULL)
 	, m_tw(tw0)
 	, m_age(0)
 	, m_complete(false)
@@ -177,11 +181,22 @@ GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0&
 	{
 		m_p2t = m_state->m_mem.GetPage2TileMap(m_TEX0);
 	}
+
+	if(hash)
+	{
+		const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[m_TEX0.PSM];
+
+		int tw = std::max<int>(1 << m_TEX0.TW, psm.bs.x) >> 3;
+		int th = std::max<int>(1 << m_TEX0.TH, psm.bs.y) >> 3;
+
+		m_hash = new uint64[tw * th](); // 0 = not converted yet
+	}
 }
 
 GSTextureCacheSW::Texture::~Texture()
 {
 	delete [] m_pages.n;
+	delete [] m_hash;
 
 	if(m_buff)
 	{
@@ -231,6 +246,11 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 	const GSOffset* RESTRICT off = m_offset;
 
 	uint32 blocks = 0;
+	uint32 skipped = 0;
+
+	uint64* RESTRICT hash = m_hash;
+
+	int hash_pitch = tw >> 3;
 
 	GSLocalMemory::readTextureBlock rtxbP = psm.rtxbP;
 
@@ -264,6 +284,13 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
+					if(hash != NULL && !UpdateHash(hash[y * hash_pitch + x], mem.BlockPtr(block)))
+					{
+						skipped++;
+
+						continue;
+					}
+
 					(mem.*rtxbP)(block, &dst[x << shift], pitch, m_TEXA);
 
 					blocks++;
@@ -288,6 +315,13 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 				{
 					m_valid[row] |= col;
 
+					if(hash != NULL && !UpdateHash(hash[y * hash_pitch + x], mem.BlockPtr(block)))
+					{
+						skipped++;
+
+						continue;
+					}
+
 					(mem.*rtxbP)(block, &dst[x << shift], pitch, m_TEXA);
 
 					blocks++;
@@ -301,6 +335,27 @@ bool GSTextureCacheSW::Texture::Update(const GSVector4i& rect)
 		m_state->m_perfmon.Put(GSPerfMon::Unswizzle, bs.x * bs.y * blocks << shift);
 	}
 
+	if(skipped > 0)
+	{
+		m_state->m_perfmon.Put(GSPerfMon::UnswizzleSkip, bs.x * bs.y * skipped << shift);
+	}
+
+	return true;
+}
+
+// returns false if the block did not change since it was last converted
+
+bool GSTextureCacheSW::Texture::UpdateHash(uint64& h, const uint8* block)
+{
+	uint64 h2 = GSUtil::Hash(block, 256) | 1;
+
+	if(h == h2)
+	{
+		return false;
+	}
+
+	h = h2;
+
 	return true;
 }
 
@@ -35,6 +35,7 @@ public:
 		GIFRegTEX0 m_TEX0;
 		GIFRegTEXA m_TEXA;
 		void* m_buff;
+		uint64* m_hash; // content hash of the converted blocks, indexed by 8x8 tiles, NULL if hashing is off
 		uint32 m_tw;
 		uint32 m_age;
 		bool m_complete;
@@ -49,10 +50,11 @@ public:
 		// fast mode: each uint32 bits map to the 32 blocks of that page
 		// repeating mode: 1 bpp image of the texture tiles (8x8), also having 512 elements is just a coincidence (worst case: (1024*1024)/(8*8)/(sizeof(uint32)*8))
 
-		Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
+		Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA, bool hash);
 		virtual ~Texture();
 
 		bool Update(const GSVector4i& r);
+		bool UpdateHash(uint64& h, const uint8* block);
 		bool Save(const std::string& fn, bool dds = false) const;
 	};
 
@@ -60,6 +62,7 @@ protected:
 	GSState* m_state;
 	std::unordered_set<Texture*> m_textures;
 	std::array<FastList<Texture*>, MAX_PAGES> m_map;
+	bool m_hash;
 
 public:
 	GSTextureCacheSW(GSState* state);
@@ -0,0 +1,75 @@
+/*
+ *	Copyright (C) 2011-2012 Hainaut gregory
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with GNU Make; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <dlfcn.h>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+static void* handle;
+
+void help()
+{
+	fprintf(stderr, "Loader SW rasterizer / WriteImage benchmark\n");
+	fprintf(stderr, "ARG1 GSdx plugin\n");
+	fprintf(stderr, "ARG2 Ini directory\n");
+	fprintf(stderr, "ARG3 Max number of threads (optional, default: all cores), or \"wi\" for the WriteImage benchmark\n");
+	fprintf(stderr, "ARG4 With \"wi\": number of upload threads (optional, default: extrathreads_upload)\n");
+	if (handle) {
+		dlclose(handle);
+	}
+	exit(1);
+}
+
+int main ( int argc, char *argv[] )
+{
+	if (argc < 3) help();
+
+	handle = dlopen(argv[1], RTLD_LAZY|RTLD_GLOBAL);
+	if (handle == NULL) {
+		fprintf(stderr, "Failed to dlopen plugin %s\n", argv[1]);
+		help();
+	}
+
+	__attribute__((stdcall)) void (*GSsetSettingsDir_ptr)(const char*);
+	__attribute__((stdcall)) void (*GSBenchmark_ptr)(char*);
+
+	const bool wi = argc > 3 && strcmp(argv[3], "wi") == 0;
+	const char* name = wi ? "GSBenchmarkWriteImage" : "GSBenchmarkSW";
+
+	GSsetSettingsDir_ptr = reinterpret_cast<decltype(GSsetSettingsDir_ptr)>(dlsym(handle, "GSsetSettingsDir"));
+	GSBenchmark_ptr = reinterpret_cast<decltype(GSBenchmark_ptr)>(dlsym(handle, name));
+
+	if (GSBenchmark_ptr == NULL) {
+		fprintf(stderr, "Plugin %s has no %s benchmark\n", argv[1], wi ? "WriteImage" : "SW");
+		help();
+	}
+
+	GSsetSettingsDir_ptr(argv[2]);
+
+	if (wi)
+		GSBenchmark_ptr(argc > 4 ? argv[4] : NULL);
+	else
+		GSBenchmark_ptr(argc > 3 ? argv[3] : NULL);
+
+	if (handle) {
+		dlclose(handle);
+	}
+}
@@ -153,6 +153,12 @@ TEST(CodegenTests, JmpTest)
 	CODEGEN_TEST_BOTH(xJB((char*)base - 0xFFFF), "0f 82 fb ff fe ff");
 }
 
+TEST(CodegenTests, MiscTest)
+{
+	CODEGEN_TEST_BOTH(xCDQ(), "99");
+	CODEGEN_TEST_BOTH(xRDTSC(), "0f 31");
+}
+
 TEST(CodegenTests, SSETest)
 {
 	CODEGEN_TEST_BOTH(xMOVAPS(xmm0, xmm1), "0f 28 c1");